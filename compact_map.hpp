@@ -0,0 +1,799 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   compact_map.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 13:27:51 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 13:27:51 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include "map_iterator.hpp"
+
+namespace ft
+{
+	// Compact node.
+	// Links are 32-bit indices into the owning arena, index 0 meaning "none". The
+	// parent index and the AVL balance factor share one word: the two low bits hold
+	// balance + 1, and the value 3 in them marks a free slot.
+	template<typename T>
+	struct CompactNode
+	{
+		T							content;
+		uint32_t					left;
+		uint32_t					right;
+		uint32_t					link;
+	};
+
+	//   key     		Type of keys.
+	//   T       	 	Type of elements.
+	//   Compare  		Comparison object used to sort the binary tree.
+	// Same AVL ordering as ft::map, but every node lives in one growable arena and
+	// carries 12 bytes of links instead of three pointers plus a heap block header.
+	// Iterators are indices and stay valid when the arena grows; references and
+	// pointers to elements do not.
+	template<
+		typename Key,
+		typename T,
+		typename Compare = ft::less<Key> >
+	class compact_map
+	{
+			typedef ft::CompactNode<ft::pair<const Key, T> >	Node;
+
+		public:
+
+			// Member Type.
+			typedef Key									key_type;
+			typedef T									mapped_type;
+			typedef Compare								key_compare;
+			typedef ft::pair<const Key, T>				value_type;
+			typedef long int							difference_type;
+			typedef size_t								size_type;
+
+		private:
+
+			// Iterator.
+			// B			Boolean to indicate if it's an iterator / a const iterator.
+			template <bool B>
+			class basic_iterator
+			{
+				public:
+					typedef typename compact_map::value_type									value_type;
+					typedef long int															difference_type;
+					typedef std::bidirectional_iterator_tag										iterator_category;
+					typedef typename chooseConst<B, value_type&, const value_type&>::type		reference;
+					typedef typename chooseConst<B, value_type*, const value_type*>::type		pointer;
+				private:
+					const compact_map*	m_map;
+					uint32_t			m_index;
+				public:
+					basic_iterator(const compact_map* map = 0, uint32_t index = 0) :
+						m_map(map), m_index(index) {}
+					basic_iterator(const basic_iterator<false>& copy) :
+						m_map(copy.getMap()), m_index(copy.getIndex()) {}
+
+					const compact_map* getMap() const { return m_map; }
+					uint32_t getIndex() const { return m_index; }
+
+					reference operator*() const { return m_map->m_nodes[m_index].content; }
+					pointer operator->() const { return &m_map->m_nodes[m_index].content; }
+
+					basic_iterator& operator++()
+					{
+						m_index = m_map->next(m_index);
+						return (*this);
+					}
+
+					basic_iterator operator++(int)
+					{
+						basic_iterator tmp(*this);
+						++(*this);
+						return (tmp);
+					}
+
+					basic_iterator& operator--()
+					{
+						m_index = m_map->prev(m_index);
+						return (*this);
+					}
+
+					basic_iterator operator--(int)
+					{
+						basic_iterator tmp(*this);
+						--(*this);
+						return (tmp);
+					}
+
+					bool operator==(const basic_iterator& it) const { return (it.m_index == m_index); }
+					bool operator!=(const basic_iterator& it) const { return (it.m_index != m_index); }
+			};
+
+		public:
+
+			typedef basic_iterator<false>				iterator;
+			typedef basic_iterator<true>				const_iterator;
+
+		private:
+
+			// Attributes.
+			Node*					m_nodes;
+			uint32_t				m_capacity;
+			uint32_t				m_used;
+			uint32_t				m_free;
+			uint32_t				m_root;
+			size_type				m_size;
+			key_compare				m_comp;
+			std::allocator<Node>	m_allocNode;
+
+			static const uint32_t	maxNodes = (1u << 30) - 1;
+			static const uint32_t	freeSlot = 3;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			explicit compact_map(const Compare& comp = Compare()) :
+			m_nodes(0), m_capacity(0), m_used(1), m_free(0), m_root(0), m_size(0), m_comp(comp) {}
+
+			// Range.
+			template<typename InputIterator>
+			compact_map(InputIterator first, InputIterator last, const Compare& comp = Compare(),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) :
+			m_nodes(0), m_capacity(0), m_used(1), m_free(0), m_root(0), m_size(0), m_comp(comp)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Copy.
+			compact_map(const compact_map& other) :
+			m_nodes(0), m_capacity(0), m_used(1), m_free(0), m_root(0), m_size(0), m_comp(other.m_comp)
+			{
+				reserve(other.m_size);
+				for (const_iterator it = other.begin(); it != other.end(); ++it)
+					insert(*it);
+			}
+
+			// Operator=.
+			compact_map& operator=(const compact_map& other)
+			{
+				compact_map tmp(other);
+				this->swap(tmp);
+				return *this;
+			}
+
+			// Destroy.
+			~compact_map()
+			{
+				clear();
+				if (m_nodes)
+					m_allocNode.deallocate(m_nodes, m_capacity);
+			}
+
+// __ Iterators
+
+			iterator begin()					{ return iterator(this, minNode(m_root)); }
+			const_iterator begin() const		{ return const_iterator(this, minNode(m_root)); }
+			iterator end()						{ return iterator(this, 0); }
+			const_iterator end() const			{ return const_iterator(this, 0); }
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return m_size == 0; }
+
+			// Size.
+			size_type size() const 		{ return m_size; }
+
+			// Max.
+			size_type max_size() const	{ return maxNodes - 1; }
+
+			// Number of nodes the arena holds without growing.
+			size_type capacity() const	{ return m_capacity ? m_capacity - 1 : 0; }
+
+			// Grows the arena so that n elements fit without reallocating.
+			void reserve(size_type n)
+			{
+				if (n > max_size())
+					throw std::length_error("compact_map::reserve: too many elements");
+				if (n + 1 > m_capacity)
+					grow(static_cast<uint32_t>(n + 1));
+			}
+
+// __ Element Access
+
+			// At
+			T& at(const Key& key)
+			{
+				uint32_t i = searchNode(key);
+				if (!i)
+					throw std::out_of_range("compact_map::at: key not found");
+				return m_nodes[i].content.second;
+			}
+
+			// At (const)
+			const T& at(const Key& key) const
+			{
+				uint32_t i = searchNode(key);
+				if (!i)
+					throw std::out_of_range("compact_map::at: key not found");
+				return m_nodes[i].content.second;
+			}
+
+			// Operator []
+			T& operator[](const Key& key)
+			{
+				uint32_t i = insert(value_type(key, T())).first.getIndex();
+				return m_nodes[i].content.second;
+			}
+
+// __ Modifiers
+
+			// Insert one element.
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				uint32_t parent = 0;
+				uint32_t x = m_root;
+				bool goLeft = false;
+				while (x)
+				{
+					int order = ft::key_order<Compare, Key>::compare(m_comp, val.first, key(x));
+					if (order == 0)
+						return ft::pair<iterator, bool>(iterator(this, x), false);
+					parent = x;
+					goLeft = order < 0;
+					x = goLeft ? m_nodes[x].left : m_nodes[x].right;
+				}
+				uint32_t z = createNode(val);
+				setParent(z, parent);
+				if (!parent)
+					m_root = z;
+				else if (goLeft)
+					m_nodes[parent].left = z;
+				else
+					m_nodes[parent].right = z;
+				retraceInsert(z);
+				++m_size;
+				return ft::pair<iterator, bool>(iterator(this, z), true);
+			}
+
+			// Inserts all elements.
+			template <typename InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Removes one element.
+			void erase(iterator position)
+			{
+				deleteNode(position.getIndex());
+			}
+
+			// Removes one element on a specific key.
+			size_type erase(const Key& key)
+			{
+				uint32_t i = searchNode(key);
+				if (!i)
+					return 0;
+				deleteNode(i);
+				return 1;
+			}
+
+			// Removes a range of elements.
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			// Swaps the content of this one.
+			void swap(compact_map& other)
+			{
+				swap(m_nodes, other.m_nodes);
+				swap(m_capacity, other.m_capacity);
+				swap(m_used, other.m_used);
+				swap(m_free, other.m_free);
+				swap(m_root, other.m_root);
+				swap(m_size, other.m_size);
+				swap(m_comp, other.m_comp);
+			}
+
+			// Removes all elements, the arena is kept for reuse.
+			void clear()
+			{
+				for (uint32_t i = 1; i < m_used; ++i)
+					if ((m_nodes[i].link & 3) != freeSlot)
+						m_allocNode.destroy(&m_nodes[i]);
+				m_used = 1;
+				m_free = 0;
+				m_root = 0;
+				m_size = 0;
+			}
+
+// __ Observers
+
+			// Return key comparison object.
+			Compare key_comp() const { return m_comp; }
+
+// __ Operations
+
+			// Searches the container for an element.
+			iterator find(const Key& key)				{ return iterator(this, searchNode(key)); }
+			const_iterator find(const Key& key) const	{ return const_iterator(this, searchNode(key)); }
+
+			// Count elements with a specific key.
+			size_type count(const Key& key) const		{ return searchNode(key) ? 1 : 0; }
+
+			// Return the element whose key is not considered to go before key.
+			iterator lower_bound(const Key& key)				{ return iterator(this, lowerBound(key)); }
+			const_iterator lower_bound(const Key& key) const	{ return const_iterator(this, lowerBound(key)); }
+
+			// Return for the element whose key is considered to go after key.
+			iterator upper_bound(const Key& key)				{ return iterator(this, upperBound(key)); }
+			const_iterator upper_bound(const Key& key) const	{ return const_iterator(this, upperBound(key)); }
+
+			// Returns the bounds of a range.
+			ft::pair<iterator, iterator> equal_range(const Key& key)
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+		private:
+
+			// Swap.
+			template <typename U>
+			void swap(U& a, U& b)
+			{
+				U tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+// __ Arena
+
+			const Key& key(uint32_t i) const		{ return m_nodes[i].content.first; }
+			uint32_t parent(uint32_t i) const		{ return m_nodes[i].link >> 2; }
+			int balance(uint32_t i) const			{ return static_cast<int>(m_nodes[i].link & 3) - 1; }
+
+			void setParent(uint32_t i, uint32_t p)	{ m_nodes[i].link = (p << 2) | (m_nodes[i].link & 3); }
+			void setBalance(uint32_t i, int b)		{ m_nodes[i].link = (m_nodes[i].link & ~3u) | static_cast<uint32_t>(b + 1); }
+
+			// Moves every live node to a bigger block; indices, and so links, are unchanged.
+			// The new block is filled completely before it replaces the old one, and
+			// freed if a copy throws, leaving the map as it was.
+			void grow(uint32_t capacity)
+			{
+				Node* nodes = m_allocNode.allocate(capacity);
+				uint32_t i = 1;
+				try
+				{
+					for (; i < m_used; ++i)
+					{
+						if ((m_nodes[i].link & 3) != freeSlot)
+							m_allocNode.construct(nodes + i, m_nodes[i]);
+						else
+						{
+							nodes[i].left = m_nodes[i].left;
+							nodes[i].link = freeSlot;
+						}
+					}
+				}
+				catch (...)
+				{
+					while (--i > 0)
+						if ((nodes[i].link & 3) != freeSlot)
+							m_allocNode.destroy(nodes + i);
+					m_allocNode.deallocate(nodes, capacity);
+					throw ;
+				}
+				for (i = 1; i < m_used; ++i)
+					if ((m_nodes[i].link & 3) != freeSlot)
+						m_allocNode.destroy(m_nodes + i);
+				if (m_nodes)
+					m_allocNode.deallocate(m_nodes, m_capacity);
+				m_nodes = nodes;
+				m_capacity = capacity;
+			}
+
+			// Takes a slot from the free list, or the next untouched one, once the element
+			// is built in place there.
+			uint32_t createNode(const value_type& val)
+			{
+				if (!m_free && m_used >= m_capacity)
+				{
+					if (m_capacity >= maxNodes)
+						throw std::length_error("compact_map::insert: too many elements");
+					uint32_t capacity = m_capacity ? m_capacity * 2 : 16;
+					grow(capacity < maxNodes ? capacity : maxNodes);
+				}
+				uint32_t i = m_free ? m_free : m_used;
+				m_allocNode.construct(&m_nodes[i].content, val);
+				if (i == m_free)
+					m_free = m_nodes[i].left;
+				else
+					++m_used;
+				m_nodes[i].left = 0;
+				m_nodes[i].right = 0;
+				m_nodes[i].link = 1;
+				return i;
+			}
+
+			void deallocateNode(uint32_t i)
+			{
+				m_allocNode.destroy(m_nodes + i);
+				m_nodes[i].left = m_free;
+				m_nodes[i].link = freeSlot;
+				m_free = i;
+			}
+
+// __ Navigation
+
+			// Strict ordering of two keys, whatever kind of comparator the map holds.
+			bool keyLess(const Key& a, const Key& b) const
+			{
+				return ft::key_order<Compare, Key>::less(m_comp, a, b);
+			}
+
+			uint32_t minNode(uint32_t i) const
+			{
+				while (i && m_nodes[i].left)
+					i = m_nodes[i].left;
+				return i;
+			}
+
+			uint32_t maxNode(uint32_t i) const
+			{
+				while (i && m_nodes[i].right)
+					i = m_nodes[i].right;
+				return i;
+			}
+
+			// Operator++, the last element steps to 0 (end).
+			uint32_t next(uint32_t i) const
+			{
+				if (m_nodes[i].right)
+					return minNode(m_nodes[i].right);
+				uint32_t p = parent(i);
+				while (p && m_nodes[p].right == i)
+				{
+					i = p;
+					p = parent(p);
+				}
+				return p;
+			}
+
+			// Operator--, end steps back to the last element.
+			uint32_t prev(uint32_t i) const
+			{
+				if (!i)
+					return maxNode(m_root);
+				if (m_nodes[i].left)
+					return maxNode(m_nodes[i].left);
+				uint32_t p = parent(i);
+				while (p && m_nodes[p].left == i)
+				{
+					i = p;
+					p = parent(p);
+				}
+				return p;
+			}
+
+			uint32_t searchNode(const Key& k) const
+			{
+				uint32_t x = m_root;
+				while (x)
+				{
+					int order = ft::key_order<Compare, Key>::compare(m_comp, k, key(x));
+					if (order == 0)
+						return x;
+					x = order < 0 ? m_nodes[x].left : m_nodes[x].right;
+				}
+				return 0;
+			}
+
+			uint32_t lowerBound(const Key& k) const
+			{
+				uint32_t x = m_root;
+				uint32_t result = 0;
+				while (x)
+				{
+					if (!keyLess(key(x), k))
+					{
+						result = x;
+						x = m_nodes[x].left;
+					}
+					else
+						x = m_nodes[x].right;
+				}
+				return result;
+			}
+
+			uint32_t upperBound(const Key& k) const
+			{
+				uint32_t x = m_root;
+				uint32_t result = 0;
+				while (x)
+				{
+					if (keyLess(k, key(x)))
+					{
+						result = x;
+						x = m_nodes[x].left;
+					}
+					else
+						x = m_nodes[x].right;
+				}
+				return result;
+			}
+
+// __ AVL Binary Search Tree
+
+			// Puts n where x used to hang under p (or at the root).
+			void replaceChild(uint32_t p, uint32_t x, uint32_t n)
+			{
+				if (!p)
+					m_root = n;
+				else if (m_nodes[p].left == x)
+					m_nodes[p].left = n;
+				else
+					m_nodes[p].right = n;
+				if (n)
+					setParent(n, p);
+			}
+
+			// LEFT ROTATION
+			// z, the right child of x, goes up. The caller reattaches z to x's old parent.
+			uint32_t rotateLeft(uint32_t x, uint32_t z)
+			{
+				uint32_t inner = m_nodes[z].left;
+				m_nodes[x].right = inner;
+				if (inner)
+					setParent(inner, x);
+				m_nodes[z].left = x;
+				setParent(x, z);
+				if (balance(z) == 0)
+				{
+					setBalance(x, 1);
+					setBalance(z, -1);
+				}
+				else
+				{
+					setBalance(x, 0);
+					setBalance(z, 0);
+				}
+				return z;
+			}
+
+			// RIGHT ROTATION
+			// z, the left child of x, goes up. The caller reattaches z to x's old parent.
+			uint32_t rotateRight(uint32_t x, uint32_t z)
+			{
+				uint32_t inner = m_nodes[z].right;
+				m_nodes[x].left = inner;
+				if (inner)
+					setParent(inner, x);
+				m_nodes[z].right = x;
+				setParent(x, z);
+				if (balance(z) == 0)
+				{
+					setBalance(x, -1);
+					setBalance(z, 1);
+				}
+				else
+				{
+					setBalance(x, 0);
+					setBalance(z, 0);
+				}
+				return z;
+			}
+
+			// RIGHT-LEFT ROTATION
+			// z is the right child of x and leans left; its left child y goes up two levels.
+			uint32_t rotateRightLeft(uint32_t x, uint32_t z)
+			{
+				uint32_t y = m_nodes[z].left;
+				uint32_t t3 = m_nodes[y].right;
+				m_nodes[z].left = t3;
+				if (t3)
+					setParent(t3, z);
+				m_nodes[y].right = z;
+				setParent(z, y);
+				uint32_t t2 = m_nodes[y].left;
+				m_nodes[x].right = t2;
+				if (t2)
+					setParent(t2, x);
+				m_nodes[y].left = x;
+				setParent(x, y);
+				int b = balance(y);
+				setBalance(x, b > 0 ? -1 : 0);
+				setBalance(z, b < 0 ? 1 : 0);
+				setBalance(y, 0);
+				return y;
+			}
+
+			// LEFT-RIGHT ROTATION
+			// z is the left child of x and leans right; its right child y goes up two levels.
+			uint32_t rotateLeftRight(uint32_t x, uint32_t z)
+			{
+				uint32_t y = m_nodes[z].right;
+				uint32_t t3 = m_nodes[y].left;
+				m_nodes[z].right = t3;
+				if (t3)
+					setParent(t3, z);
+				m_nodes[y].left = z;
+				setParent(z, y);
+				uint32_t t2 = m_nodes[y].right;
+				m_nodes[x].left = t2;
+				if (t2)
+					setParent(t2, x);
+				m_nodes[y].right = x;
+				setParent(x, y);
+				int b = balance(y);
+				setBalance(x, b < 0 ? 1 : 0);
+				setBalance(z, b > 0 ? -1 : 0);
+				setBalance(y, 0);
+				return y;
+			}
+
+			// Walks up from a new leaf, updating balance factors until a subtree keeps its
+			// height. At most one single or double rotation is needed.
+			void retraceInsert(uint32_t z)
+			{
+				for (uint32_t x = parent(z); x; x = parent(z))
+				{
+					uint32_t g = parent(x);
+					uint32_t n;
+					if (m_nodes[x].right == z)
+					{
+						if (balance(x) <= 0)
+						{
+							setBalance(x, balance(x) + 1);
+							if (balance(x) == 0)
+								return ;
+							z = x;
+							continue ;
+						}
+						n = balance(z) < 0 ? rotateRightLeft(x, z) : rotateLeft(x, z);
+					}
+					else
+					{
+						if (balance(x) >= 0)
+						{
+							setBalance(x, balance(x) - 1);
+							if (balance(x) == 0)
+								return ;
+							z = x;
+							continue ;
+						}
+						n = balance(z) > 0 ? rotateLeftRight(x, z) : rotateRight(x, z);
+					}
+					replaceChild(g, x, n);
+					return ;
+				}
+			}
+
+			// Walks up from the parent of a removed position; `fromLeft` tells which of
+			// x's subtrees lost one level. Stops as soon as a subtree keeps its height.
+			void retraceErase(uint32_t x, bool fromLeft)
+			{
+				while (x)
+				{
+					uint32_t g = parent(x);
+					bool xIsLeft = g && m_nodes[g].left == x;
+					uint32_t n;
+					int b;
+					if (fromLeft)
+					{
+						if (balance(x) <= 0)
+						{
+							setBalance(x, balance(x) + 1);
+							if (balance(x) == 1)
+								return ;
+							x = g;
+							fromLeft = xIsLeft;
+							continue ;
+						}
+						uint32_t z = m_nodes[x].right;
+						b = balance(z);
+						n = b < 0 ? rotateRightLeft(x, z) : rotateLeft(x, z);
+					}
+					else
+					{
+						if (balance(x) >= 0)
+						{
+							setBalance(x, balance(x) - 1);
+							if (balance(x) == -1)
+								return ;
+							x = g;
+							fromLeft = xIsLeft;
+							continue ;
+						}
+						uint32_t z = m_nodes[x].left;
+						b = balance(z);
+						n = b > 0 ? rotateLeftRight(x, z) : rotateRight(x, z);
+					}
+					replaceChild(g, x, n);
+					if (b == 0)
+						return ;
+					x = g;
+					fromLeft = xIsLeft;
+				}
+			}
+
+			// Unlinks a node, putting its successor in its place when it has two children,
+			// then rebalances and gives the slot back to the free list.
+			void deleteNode(uint32_t del)
+			{
+				uint32_t p = parent(del);
+				uint32_t left = m_nodes[del].left;
+				uint32_t right = m_nodes[del].right;
+				uint32_t x;
+				bool fromLeft;
+				if (left && right)
+				{
+					uint32_t s = minNode(right);
+					if (parent(s) != del)
+					{
+						x = parent(s);
+						fromLeft = true;
+						uint32_t r = m_nodes[s].right;
+						m_nodes[x].left = r;
+						if (r)
+							setParent(r, x);
+						m_nodes[s].right = right;
+						setParent(right, s);
+					}
+					else
+					{
+						x = s;
+						fromLeft = false;
+					}
+					m_nodes[s].left = left;
+					setParent(left, s);
+					replaceChild(p, del, s);
+					setBalance(s, balance(del));
+				}
+				else
+				{
+					x = p;
+					fromLeft = p && m_nodes[p].left == del;
+					replaceChild(p, del, left ? left : right);
+				}
+				retraceErase(x, fromLeft);
+				deallocateNode(del);
+				--m_size;
+			}
+	};
+
+	// Non member functions
+	template <typename Key, typename T, typename Compare>
+	void swap(ft::compact_map<Key, T, Compare> &lhs, ft::compact_map<Key, T, Compare> &rhs)
+	{ lhs.swap(rhs); }
+
+	template <typename Key, typename T, typename Compare>
+	bool operator==(const ft::compact_map<Key, T, Compare> &lhs, const ft::compact_map<Key, T, Compare> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <typename Key, typename T, typename Compare>
+	bool operator!=(const ft::compact_map<Key, T, Compare> &lhs, const ft::compact_map<Key, T, Compare> &rhs)
+	{ return (!(lhs == rhs)); }
+}
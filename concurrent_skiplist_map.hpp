@@ -0,0 +1,702 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   concurrent_skiplist_map.hpp                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:05:12 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 14:05:12 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <stdint.h>
+#include "map_iterator.hpp"
+
+namespace ft
+{
+	// Epoch-based reclamation.
+	// Readers pin the global epoch while they hold pointers into shared nodes. A node
+	// retired during epoch e is freed once the global epoch reaches e + 2: the epoch
+	// only moves forward when every pinned thread has seen the current one, so by then
+	// nobody can still reach it. One domain serves every concurrent container.
+	class epoch_domain
+	{
+		public:
+			// Base of anything handed to retire().
+			struct retired
+			{
+				retired*			retiredNext;
+				unsigned long long	retiredEpoch;
+				void				(*reclaim)(retired*);
+			};
+
+			// Pins the calling thread's epoch while alive. Guards nest, and belong to the
+			// thread that created them.
+			class guard
+			{
+				public:
+					guard() { epoch_domain::instance().enter(); }
+					guard(const guard&) { epoch_domain::instance().enter(); }
+					~guard() { epoch_domain::instance().leave(); }
+					guard& operator=(const guard&) { return *this; }
+			};
+
+		private:
+			// Per-thread state, recycled when its thread exits.
+			struct Record
+			{
+				std::atomic<unsigned long long>	state;
+				std::atomic<bool>				inUse;
+				Record*							next;
+				unsigned int					nesting;
+				retired*						limbo;
+				size_t							limboSize;
+				size_t							threshold;
+
+				Record() : state(0), inUse(true), next(0), nesting(0), limbo(0), limboSize(0),
+				threshold(reclaimBatch) {}
+			};
+
+			// Gives the record back when the thread exits.
+			struct Slot
+			{
+				Record*	record;
+
+				Slot() : record(0) {}
+				~Slot() { if (record) epoch_domain::instance().release(record); }
+			};
+
+			// Attributes.
+			std::atomic<unsigned long long>	m_epoch;
+			std::atomic<Record*>			m_records;
+
+			static const size_t				reclaimBatch = 64;
+
+			epoch_domain() : m_epoch(0), m_records(0) {}
+			epoch_domain(const epoch_domain&);
+			epoch_domain& operator=(const epoch_domain&);
+
+		public:
+			// Frees whatever is still waiting, threads are gone by now.
+			~epoch_domain()
+			{
+				Record* r = m_records.load();
+				while (r)
+				{
+					Record* next = r->next;
+					reclaim(r, ~0ULL);
+					delete r;
+					r = next;
+				}
+			}
+
+			// The process-wide domain.
+			static epoch_domain& instance()
+			{
+				static epoch_domain domain;
+				return domain;
+			}
+
+			// Pins the current epoch, state holds epoch << 1 | active.
+			void enter()
+			{
+				Record* r = local();
+				if (r->nesting++ == 0)
+					r->state.store((m_epoch.load() << 1) | 1);
+			}
+
+			// Unpins once the outermost guard goes away.
+			void leave()
+			{
+				Record* r = local();
+				if (--r->nesting == 0)
+					r->state.store(0);
+			}
+
+			// Takes a node that no shared link reaches anymore. Call it inside a guard.
+			void retire(retired* node)
+			{
+				Record* r = local();
+				node->retiredEpoch = m_epoch.load();
+				node->retiredNext = r->limbo;
+				r->limbo = node;
+				if (++r->limboSize >= r->threshold)
+				{
+					tryAdvance();
+					reclaim(r, m_epoch.load());
+					r->threshold = r->limboSize + reclaimBatch;
+				}
+			}
+
+		private:
+			// Record of the calling thread.
+			Record* local()
+			{
+				static thread_local Slot slot;
+				if (!slot.record)
+					slot.record = acquire();
+				return slot.record;
+			}
+
+			// Reuses a released record or publishes a new one.
+			Record* acquire()
+			{
+				for (Record* r = m_records.load(); r; r = r->next)
+				{
+					bool expected = false;
+					if (!r->inUse.load() && r->inUse.compare_exchange_strong(expected, true))
+						return r;
+				}
+				Record* r = new Record();
+				r->next = m_records.load();
+				while (!m_records.compare_exchange_weak(r->next, r))
+					;
+				return r;
+			}
+
+			// Leftovers stay in the limbo list for the next owner of the record.
+			void release(Record* r)
+			{
+				reclaim(r, m_epoch.load());
+				r->threshold = r->limboSize + reclaimBatch;
+				r->inUse.store(false);
+			}
+
+			// Moves the epoch forward if every pinned thread has caught up with it.
+			void tryAdvance()
+			{
+				unsigned long long epoch = m_epoch.load();
+				for (Record* r = m_records.load(); r; r = r->next)
+				{
+					unsigned long long state = r->state.load();
+					if ((state & 1) && (state >> 1) != epoch)
+						return;
+				}
+				m_epoch.compare_exchange_strong(epoch, epoch + 1);
+			}
+
+			// Frees the nodes retired two epochs or more before epoch.
+			static void reclaim(Record* r, unsigned long long epoch)
+			{
+				retired** link = &r->limbo;
+				while (*link)
+				{
+					retired* node = *link;
+					if (node->retiredEpoch + 2 <= epoch)
+					{
+						*link = node->retiredNext;
+						node->reclaim(node);
+						--r->limboSize;
+					}
+					else
+						link = &node->retiredNext;
+				}
+			}
+	};
+
+	//   key     		Type of keys.
+	//   T       	 	Type of elements.
+	//   Compare  		Comparison object used to order the lists.
+	//   Allocator		Stateless allocator for the pairs.
+	// Ordered map for many threads at once: find, insert, erase and iteration are
+	// lock-free. Elements live in a skip list whose links carry a deletion mark in
+	// their low bit, and erased nodes go back through ft::epoch_domain. Elements can't
+	// change once inserted, so iterators are const. Each iterator pins the epoch of the
+	// thread that made it: keep iterators on that thread and don't hold them for long.
+	// Construction, destruction and assignment must not race with other operations.
+	template<
+		typename Key,
+		typename T,
+		typename Compare = ft::less<Key>,
+		typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class concurrent_skiplist_map
+	{
+		public:
+
+			// Member Type.
+			typedef Key									key_type;
+			typedef T									mapped_type;
+			typedef Compare								key_compare;
+			typedef Allocator							allocator_type;
+			typedef ft::pair<const Key, T>				value_type;
+			typedef const value_type&					reference;
+			typedef const value_type&					const_reference;
+			typedef long int							difference_type;
+			typedef size_t								size_type;
+
+		private:
+
+			struct Node;
+			typedef std::atomic<Node*>					Link;
+
+			// Forward links, one per level. The head is a tower without an element.
+			struct Tower
+			{
+				Link*	next;
+				int		height;
+			};
+
+			// Handoff counts the inserter and the eraser, the second one retires the node.
+			struct Node : Tower, epoch_domain::retired
+			{
+				std::atomic<int>	handoff;
+				value_type			content;
+			};
+
+			static const int	maxHeight = 24;
+
+		public:
+
+			// Iterator.
+			class const_iterator
+			{
+				public:
+					typedef typename concurrent_skiplist_map::value_type	value_type;
+					typedef long int										difference_type;
+					typedef std::forward_iterator_tag						iterator_category;
+					typedef const value_type&								reference;
+					typedef const value_type*								pointer;
+				private:
+					epoch_domain::guard	m_guard;
+					Node*				m_node;
+				public:
+					const_iterator(Node* node = 0) : m_node(node) {}
+
+					Node* getNode() const { return m_node; }
+
+					reference operator*() const { return m_node->content; }
+					pointer operator->() const { return &m_node->content; }
+
+					const_iterator& operator++()
+					{
+						m_node = nextLive(m_node);
+						return (*this);
+					}
+
+					const_iterator operator++(int)
+					{
+						const_iterator tmp(*this);
+						++(*this);
+						return (tmp);
+					}
+
+					bool operator==(const const_iterator& it) const { return (it.m_node == m_node); }
+					bool operator!=(const const_iterator& it) const { return (it.m_node != m_node); }
+			};
+
+			typedef const_iterator						iterator;
+
+		private:
+
+			// Attributes.
+			Tower							m_head;
+			std::atomic<difference_type>	m_size;
+			key_compare						m_comp;
+			allocator_type					m_allocPair;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			explicit concurrent_skiplist_map(const Compare& comp = Compare(), const Allocator& alloc = Allocator()) :
+			m_size(0), m_comp(comp), m_allocPair(alloc)
+			{
+				initHead();
+			}
+
+			// Range.
+			template<typename InputIterator>
+			concurrent_skiplist_map(InputIterator first, InputIterator last, const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator(),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) :
+			m_size(0), m_comp(comp), m_allocPair(alloc)
+			{
+				initHead();
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Copy, with the allocator other's selects for a copy.
+			concurrent_skiplist_map(const concurrent_skiplist_map& other) :
+			m_size(0), m_comp(other.m_comp),
+			m_allocPair(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_allocPair))
+			{
+				initHead();
+				for (const_iterator it = other.begin(); it != other.end(); ++it)
+					insert(*it);
+			}
+
+			// Operator=.
+			concurrent_skiplist_map& operator=(const concurrent_skiplist_map& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					m_comp = other.m_comp;
+					for (const_iterator it = other.begin(); it != other.end(); ++it)
+						insert(*it);
+				}
+				return *this;
+			}
+
+			// Destroy. Nodes still linked are live, erased ones belong to the epoch domain.
+			~concurrent_skiplist_map()
+			{
+				Node* node = unmarked(m_head.next[0].load());
+				while (node)
+				{
+					Node* next = unmarked(node->next[0].load());
+					destroyNode(node);
+					node = next;
+				}
+				std::allocator<Link>().deallocate(m_head.next, maxHeight);
+			}
+
+// __ Iterators
+
+			const_iterator begin() const
+			{
+				epoch_domain::guard guard;
+				Node* first = unmarked(m_head.next[0].load());
+				if (first && isMarked(first->next[0].load()))
+					first = nextLive(first);
+				return const_iterator(first);
+			}
+
+			const_iterator end() const	{ return const_iterator(); }
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return begin() == end(); }
+
+			// Size, a snapshot while writers are active. An erase may count down before
+			// the insert it follows has counted up, so the counter is signed and a
+			// passing negative value reads as empty.
+			size_type size() const
+			{
+				difference_type n = m_size.load();
+				return n < 0 ? 0 : static_cast<size_type>(n);
+			}
+
+			// Max.
+			size_type max_size() const	{ return m_allocPair.max_size(); }
+
+// __ Modifiers
+
+			// Insert one element, lock-free.
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				epoch_domain::guard guard;
+				Tower* preds[maxHeight];
+				Node* succs[maxHeight];
+				Node* node = 0;
+				while (true)
+				{
+					if (locate(val.first, preds, succs))
+					{
+						if (node)
+							destroyNode(node);
+						return ft::pair<iterator, bool>(iterator(succs[0]), false);
+					}
+					if (!node)
+						node = createNode(val);
+					for (int level = 0; level < node->height; ++level)
+						node->next[level].store(succs[level]);
+					Node* expected = succs[0];
+					if (preds[0]->next[0].compare_exchange_strong(expected, node))
+						break;
+				}
+				++m_size;
+				linkUpperLevels(node, preds, succs);
+				handOff(node);
+				return ft::pair<iterator, bool>(iterator(node), true);
+			}
+
+			// Inserts all elements.
+			template <typename InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Removes the element the iterator points to, unless another thread got there first.
+			void erase(const_iterator position)
+			{
+				eraseNode(position.getNode());
+			}
+
+			// Removes one element on a specific key.
+			size_type erase(const Key& key)
+			{
+				epoch_domain::guard guard;
+				Tower* preds[maxHeight];
+				Node* succs[maxHeight];
+				if (!locate(key, preds, succs))
+					return 0;
+				return eraseNode(succs[0]) ? 1 : 0;
+			}
+
+			// Removes all elements, one at a time so that other threads can keep going.
+			void clear()
+			{
+				epoch_domain::guard guard;
+				for (const_iterator it = begin(); it != end(); it = begin())
+					eraseNode(it.getNode());
+			}
+
+// __ Observers
+
+			// Return key comparison object.
+			Compare key_comp() const { return m_comp; }
+
+// __ Operations
+
+			// Find.
+			const_iterator find(const Key& key) const
+			{
+				epoch_domain::guard guard;
+				Node* node = boundNode(key, false);
+				if (node && !keyLess(key, node->content.first))
+					return const_iterator(node);
+				return end();
+			}
+
+			// Count.
+			size_type count(const Key& key) const
+			{
+				return find(key) == end() ? 0 : 1;
+			}
+
+			// Lower bound.
+			const_iterator lower_bound(const Key& key) const
+			{
+				epoch_domain::guard guard;
+				return const_iterator(boundNode(key, false));
+			}
+
+			// Upper bound.
+			const_iterator upper_bound(const Key& key) const
+			{
+				epoch_domain::guard guard;
+				return const_iterator(boundNode(key, true));
+			}
+
+			// Equal range.
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+// __ Allocator
+
+			allocator_type get_allocator() const { return m_allocPair; }
+
+// __ Skip List
+
+		private:
+
+			static bool isMarked(Node* node) { return reinterpret_cast<uintptr_t>(node) & 1; }
+			static Node* marked(Node* node) { return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(node) | 1); }
+			static Node* unmarked(Node* node) { return reinterpret_cast<Node*>(reinterpret_cast<uintptr_t>(node) & ~uintptr_t(1)); }
+
+			// Strict ordering of two keys, whatever kind of comparator the map holds.
+			bool keyLess(const Key& a, const Key& b) const
+			{
+				return ft::key_order<Compare, Key>::less(m_comp, a, b);
+			}
+
+			// The domain is touched first so that it outlives every map, static ones included.
+			void initHead()
+			{
+				epoch_domain::instance();
+				m_head.height = maxHeight;
+				m_head.next = std::allocator<Link>().allocate(maxHeight);
+				for (int level = 0; level < maxHeight; ++level)
+					new (&m_head.next[level]) Link(0);
+			}
+
+			// Geometric height with p = 1/2, from a per-thread xorshift generator.
+			static int randomHeight()
+			{
+				static thread_local uint64_t seed = 0;
+				if (!seed)
+					seed = (reinterpret_cast<uintptr_t>(&seed) * 0x9E3779B97F4A7C15ULL) | 1;
+				seed ^= seed << 13;
+				seed ^= seed >> 7;
+				seed ^= seed << 17;
+				return 1 + __builtin_ctzll(seed | (1ULL << (maxHeight - 1)));
+			}
+
+			Node* createNode(const value_type& val)
+			{
+				Node* node = std::allocator<Node>().allocate(1);
+				m_allocPair.construct(&node->content, val);
+				node->height = randomHeight();
+				node->next = std::allocator<Link>().allocate(node->height);
+				for (int level = 0; level < node->height; ++level)
+					new (&node->next[level]) Link(0);
+				new (&node->handoff) std::atomic<int>(0);
+				node->reclaim = &reclaimNode;
+				return node;
+			}
+
+			// Static so the epoch domain can free nodes after the map is gone.
+			static void destroyNode(Node* node)
+			{
+				allocator_type().destroy(&node->content);
+				std::allocator<Link>().deallocate(node->next, node->height);
+				std::allocator<Node>().deallocate(node, 1);
+			}
+
+			static void reclaimNode(epoch_domain::retired* node)
+			{
+				destroyNode(static_cast<Node*>(node));
+			}
+
+			// Next node at the bottom level that is not being erased.
+			static Node* nextLive(Node* node)
+			{
+				Node* next = unmarked(node->next[0].load());
+				while (next && isMarked(next->next[0].load()))
+					next = unmarked(next->next[0].load());
+				return next;
+			}
+
+			// First live node not ordered before key (or after it, when upper). Read-only,
+			// marked nodes are stepped over rather than unlinked.
+			Node* boundNode(const Key& key, bool upper) const
+			{
+				const Tower* pred = &m_head;
+				Node* curr = 0;
+				for (int level = maxHeight - 1; level >= 0; --level)
+				{
+					curr = unmarked(pred->next[level].load());
+					while (curr)
+					{
+						Node* succ = curr->next[level].load();
+						if (isMarked(succ))
+						{
+							curr = unmarked(succ);
+							continue;
+						}
+						if (upper ? keyLess(key, curr->content.first) : !keyLess(curr->content.first, key))
+							break;
+						pred = curr;
+						curr = succ;
+					}
+				}
+				return curr;
+			}
+
+			// Fills the last tower before key and the first node from key on, for every
+			// level, unlinking the marked nodes met on the way. True if key is present.
+			bool locate(const Key& key, Tower** preds, Node** succs)
+			{
+				bool found;
+				while (!tryLocate(key, preds, succs, found))
+					;
+				return found;
+			}
+
+			// One pass of locate, false when an unlink lost a race and the pass must restart.
+			bool tryLocate(const Key& key, Tower** preds, Node** succs, bool& found)
+			{
+				Tower* pred = &m_head;
+				Node* curr = 0;
+				for (int level = maxHeight - 1; level >= 0; --level)
+				{
+					curr = unmarked(pred->next[level].load());
+					while (curr)
+					{
+						Node* succ = curr->next[level].load();
+						while (isMarked(succ))
+						{
+							Node* expected = curr;
+							if (!pred->next[level].compare_exchange_strong(expected, unmarked(succ)))
+								return false;
+							curr = unmarked(succ);
+							if (!curr)
+								break;
+							succ = curr->next[level].load();
+						}
+						if (!curr || !keyLess(curr->content.first, key))
+							break;
+						pred = curr;
+						curr = succ;
+					}
+					preds[level] = pred;
+					succs[level] = curr;
+				}
+				found = curr && !keyLess(key, curr->content.first);
+				return true;
+			}
+
+			// Links a node already in the bottom level into its upper levels. Stops as soon
+			// as an eraser marks it: a node being erased must not gain new links.
+			void linkUpperLevels(Node* node, Tower** preds, Node** succs)
+			{
+				for (int level = 1; level < node->height; ++level)
+				{
+					while (true)
+					{
+						Node* succ = node->next[level].load();
+						if (isMarked(succ))
+							return;
+						if (succ != succs[level] && !node->next[level].compare_exchange_strong(succ, succs[level]))
+							return;
+						Node* expected = succs[level];
+						if (preds[level]->next[level].compare_exchange_strong(expected, node))
+							break;
+						if (!locate(node->content.first, preds, succs) || succs[0] != node)
+							return;
+					}
+				}
+			}
+
+			// Marks every level top-down; the mark on the bottom level is the erase itself,
+			// and only one thread gets to set it.
+			bool eraseNode(Node* node)
+			{
+				for (int level = node->height - 1; level > 0; --level)
+				{
+					Node* succ = node->next[level].load();
+					while (!isMarked(succ) && !node->next[level].compare_exchange_weak(succ, marked(succ)))
+						;
+				}
+				Node* succ = node->next[0].load();
+				while (true)
+				{
+					if (isMarked(succ))
+						return false;
+					if (node->next[0].compare_exchange_weak(succ, marked(succ)))
+						break;
+				}
+				--m_size;
+				handOff(node);
+				return true;
+			}
+
+			// Called once by the inserter when it stops linking, once by the eraser. The
+			// second caller knows no new link can appear, unlinks what is left and retires.
+			void handOff(Node* node)
+			{
+				if (node->handoff.fetch_add(1) == 1)
+				{
+					Tower* preds[maxHeight];
+					Node* succs[maxHeight];
+					locate(node->content.first, preds, succs);
+					epoch_domain::instance().retire(node);
+				}
+			}
+	};
+}
@@ -0,0 +1,453 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frozen_map.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 11:02:14 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 11:02:14 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include "map.hpp"
+
+namespace ft
+{
+	// Frozen map iterator.
+	// Walks the Eytzinger (BFS) array in key order. Index 0 is the end position,
+	// the root lives at index 1 and the children of k are 2k and 2k + 1.
+
+	// Key			Type of keys.
+	// T			Type of mapped elements.
+	template <typename Key, typename T>
+	class frozen_map_iterator
+	{
+		public:
+			typedef ft::pair<const Key&, const T&>			value_type;
+			typedef long int								difference_type;
+			typedef size_t									size_type;
+			typedef std::bidirectional_iterator_tag			iterator_category;
+			typedef value_type								reference;
+
+			// Holds the pair returned by operator-> for the duration of the expression.
+			struct pointer
+			{
+				value_type	m_pair;
+				pointer(const value_type& pair) : m_pair(pair) {}
+				const value_type* operator->() const { return &m_pair; }
+			};
+
+		private:
+			const Key*		m_keys;
+			const T*		m_values;
+			size_type		m_size;
+			size_type		m_index;
+
+		public:
+
+// __ Constructors & Destructor
+
+			// Default.
+			frozen_map_iterator(const Key* keys = 0, const T* values = 0,
+			size_type size = 0, size_type index = 0) :
+				m_keys(keys), m_values(values), m_size(size), m_index(index) {}
+
+			// Copy.
+			frozen_map_iterator(const frozen_map_iterator& copy) :
+				m_keys(copy.m_keys), m_values(copy.m_values), m_size(copy.m_size), m_index(copy.m_index) {}
+
+			// Destroy.
+			~frozen_map_iterator() {}
+
+			// Operator=.
+			frozen_map_iterator& operator=(const frozen_map_iterator& assign)
+			{
+				if (this != &assign)
+				{
+					m_keys = assign.m_keys;
+					m_values = assign.m_values;
+					m_size = assign.m_size;
+					m_index = assign.m_index;
+				}
+				return (*this);
+			}
+
+// __ Getters
+
+			size_type getIndex() const { return m_index; }
+			const Key& key() const { return m_keys[m_index]; }
+			const T& value() const { return m_values[m_index]; }
+
+// __ Operators
+
+			reference operator*() const { return value_type(m_keys[m_index], m_values[m_index]); }
+			pointer operator->() const { return pointer(**this); }
+
+			// In-order successor: leftmost node of the right subtree, or else climb while
+			// we are a right child (odd index) and step to the parent once more.
+			frozen_map_iterator& operator++()
+			{
+				if (2 * m_index + 1 <= m_size)
+				{
+					m_index = 2 * m_index + 1;
+					while (2 * m_index <= m_size)
+						m_index = 2 * m_index;
+				}
+				else
+					m_index >>= __builtin_ffsl(~m_index);
+				return (*this);
+			}
+
+			frozen_map_iterator operator++(int)
+			{
+				frozen_map_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+
+			// In-order predecessor, end() steps back to the rightmost node.
+			frozen_map_iterator& operator--()
+			{
+				if (m_index == 0)
+				{
+					m_index = m_size ? 1 : 0;
+					while (m_index && 2 * m_index + 1 <= m_size)
+						m_index = 2 * m_index + 1;
+				}
+				else if (2 * m_index <= m_size)
+				{
+					m_index = 2 * m_index;
+					while (2 * m_index + 1 <= m_size)
+						m_index = 2 * m_index + 1;
+				}
+				else
+					m_index >>= __builtin_ffsl(m_index);
+				return (*this);
+			}
+
+			frozen_map_iterator operator--(int)
+			{
+				frozen_map_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const frozen_map_iterator& it) const { return (it.m_index == m_index); }
+			bool operator!=(const frozen_map_iterator& it) const { return (it.m_index != m_index); }
+	};
+
+	// Read-only index built once from an ft::map. Keys are laid out in Eytzinger
+	// order in one contiguous array with the mapped values in a parallel array,
+	// so a lookup is a branchless descent over an implicit tree with no pointers.
+
+	//   key     		Type of keys.
+	//   T       	 	Type of elements.
+	//   Compare  		Comparison object used to order the keys.
+	template<
+		typename Key,
+		typename T,
+		typename Compare = ft::less<Key> >
+	class frozen_map
+	{
+		public:
+
+			// Member Type.
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef Compare										key_compare;
+			typedef size_t										size_type;
+			typedef long int									difference_type;
+
+			typedef ft::frozen_map_iterator<Key, T>				iterator;
+			typedef ft::frozen_map_iterator<Key, T>				const_iterator;
+			typedef typename iterator::value_type				value_type;
+
+		private:
+
+			// Attributes.
+			Key*					m_keys;
+			T*						m_values;
+			size_type				m_size;
+			key_compare				m_comp;
+			std::allocator<Key>		m_allocKey;
+			std::allocator<T>		m_allocValue;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			explicit frozen_map(const Compare& comp = Compare()) :
+			m_keys(0), m_values(0), m_size(0), m_comp(comp) {}
+
+			// From a map, the content is copied and the map can be dropped afterwards. A
+			// throwing copy gives back everything built so far.
+			template <typename Alloc, typename Balance, typename Augment>
+			explicit frozen_map(const ft::map<Key, T, Compare, Alloc, Balance, Augment>& src) :
+			m_keys(0), m_values(0), m_size(0), m_comp(src.key_comp())
+			{
+				allocate(src.size());
+				typename ft::map<Key, T, Compare, Alloc, Balance, Augment>::const_iterator it = src.begin();
+				size_type built = 0;
+				try
+				{
+					fill(1, src.size(), it, built);
+				}
+				catch (...)
+				{
+					unfill(1, src.size(), built);
+					release(src.size());
+					throw ;
+				}
+				m_size = src.size();
+			}
+
+			// Copy.
+			frozen_map(const frozen_map& other) :
+			m_keys(0), m_values(0), m_size(0), m_comp(other.m_comp)
+			{
+				allocate(other.m_size);
+				try
+				{
+					for (; m_size < other.m_size; ++m_size)
+						constructAt(m_size + 1, other.m_keys[m_size + 1], other.m_values[m_size + 1]);
+				}
+				catch (...)
+				{
+					release(other.m_size);
+					throw ;
+				}
+			}
+
+			// Operator=.
+			frozen_map& operator=(const frozen_map& other)
+			{
+				frozen_map tmp(other);
+				this->swap(tmp);
+				return *this;
+			}
+
+			// Destroy.
+			~frozen_map() { release(m_size); }
+
+// __ Iterators
+
+			const_iterator begin() const
+			{
+				size_type k = m_size ? 1 : 0;
+				while (k && 2 * k <= m_size)
+					k = 2 * k;
+				return const_iterator(m_keys, m_values, m_size, k);
+			}
+			const_iterator end() const		{ return const_iterator(m_keys, m_values, m_size, 0); }
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return m_size == 0; }
+
+			// Size.
+			size_type size() const 		{ return m_size; }
+
+// __ Element Access
+
+			// At.
+			const T& at(const Key& key) const
+			{
+				size_type k = lowerBoundIndex(key);
+				if (k == 0 || keyLess(key, m_keys[k]))
+					throw std::out_of_range("frozen_map::at: key not found");
+				return m_values[k];
+			}
+
+// __ Modifiers
+
+			// Swaps the content of this one.
+			void swap(frozen_map& other)
+			{
+				swap(m_keys, other.m_keys);
+				swap(m_values, other.m_values);
+				swap(m_size, other.m_size);
+				swap(m_comp, other.m_comp);
+			}
+
+// __ Observers
+
+			// Return key comparison object.
+			Compare key_comp() const { return m_comp; }
+
+// __ Operations
+
+			// Searches the index for an element.
+			const_iterator find(const Key& key) const
+			{
+				size_type k = lowerBoundIndex(key);
+				if (k == 0 || keyLess(key, m_keys[k]))
+					return end();
+				return const_iterator(m_keys, m_values, m_size, k);
+			}
+
+			// Count elements with a specific key.
+			size_type count(const Key& key) const { return find(key) != end(); }
+
+			// Return the element whose key is not considered to go before key.
+			const_iterator lower_bound(const Key& key) const
+			{
+				return const_iterator(m_keys, m_values, m_size, lowerBoundIndex(key));
+			}
+
+			// Return the element whose key is considered to go after key.
+			const_iterator upper_bound(const Key& key) const
+			{
+				return const_iterator(m_keys, m_values, m_size, upperBoundIndex(key));
+			}
+
+			// Returns the bounds of a range.
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+		private:
+
+			// Swap.
+			template <typename U>
+			void swap(U& a, U& b)
+			{
+				U tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+// __ Eytzinger layout
+
+			// Number of keys sharing one cache line, used as the prefetch stride:
+			// the block at k * stride holds the descendants a few levels below k.
+			static size_type prefetchStride()
+			{
+				return sizeof(Key) < 64 ? 64 / sizeof(Key) : 1;
+			}
+
+			// Strict ordering of two keys, whatever kind of comparator the map holds.
+			bool keyLess(const Key& a, const Key& b) const
+			{
+				return ft::key_order<Compare, Key>::less(m_comp, a, b);
+			}
+
+			// Slot 0 is never constructed so that the root sits at index 1.
+			void allocate(size_type n)
+			{
+				if (n == 0)
+					return ;
+				m_keys = m_allocKey.allocate(n + 1);
+				try
+				{
+					m_values = m_allocValue.allocate(n + 1);
+				}
+				catch (...)
+				{
+					m_allocKey.deallocate(m_keys, n + 1);
+					m_keys = 0;
+					throw ;
+				}
+			}
+
+			// Destroys the m_size elements and frees arrays sized for capacity of them.
+			void release(size_type capacity)
+			{
+				for (size_type i = 1; i <= m_size; ++i)
+				{
+					m_allocKey.destroy(m_keys + i);
+					m_allocValue.destroy(m_values + i);
+				}
+				if (m_keys)
+				{
+					m_allocKey.deallocate(m_keys, capacity + 1);
+					m_allocValue.deallocate(m_values, capacity + 1);
+				}
+				m_keys = 0;
+				m_values = 0;
+				m_size = 0;
+			}
+
+			// Builds one element, the key is destroyed again if the value throws.
+			void constructAt(size_type k, const Key& key, const T& value)
+			{
+				m_allocKey.construct(m_keys + k, key);
+				try
+				{
+					m_allocValue.construct(m_values + k, value);
+				}
+				catch (...)
+				{
+					m_allocKey.destroy(m_keys + k);
+					throw ;
+				}
+			}
+
+			// In-order walk of the implicit tree, consuming the sorted source as it goes
+			// and counting the elements built.
+			template <typename It>
+			void fill(size_type k, size_type n, It& it, size_type& built)
+			{
+				if (k > n)
+					return ;
+				fill(2 * k, n, it, built);
+				constructAt(k, it->first, it->second);
+				++built;
+				++it;
+				fill(2 * k + 1, n, it, built);
+			}
+
+			// Destroys the first `built` elements of the same walk, after fill() threw.
+			void unfill(size_type k, size_type n, size_type& built)
+			{
+				if (k > n || built == 0)
+					return ;
+				unfill(2 * k, n, built);
+				if (built == 0)
+					return ;
+				m_allocKey.destroy(m_keys + k);
+				m_allocValue.destroy(m_values + k);
+				--built;
+				unfill(2 * k + 1, n, built);
+			}
+
+			// The branchless descent: every level only chooses between 2k and 2k + 1.
+			// Once past the leaves, the trailing ones of k are the right turns taken
+			// after the last left turn; dropping them and one more bit gives the answer.
+			size_type lowerBoundIndex(const Key& key) const
+			{
+				size_type k = 1;
+				size_type stride = prefetchStride();
+				while (k <= m_size)
+				{
+					__builtin_prefetch(m_keys + k * stride);
+					k = 2 * k + keyLess(m_keys[k], key);
+				}
+				return k >> __builtin_ffsl(~k);
+			}
+
+			size_type upperBoundIndex(const Key& key) const
+			{
+				size_type k = 1;
+				size_type stride = prefetchStride();
+				while (k <= m_size)
+				{
+					__builtin_prefetch(m_keys + k * stride);
+					k = 2 * k + !keyLess(key, m_keys[k]);
+				}
+				return k >> __builtin_ffsl(~k);
+			}
+	};
+
+	// Non member functions
+	template <typename Key, typename T, typename Compare>
+	void swap(ft::frozen_map<Key, T, Compare> &lhs, ft::frozen_map<Key, T, Compare> &rhs)
+	{ lhs.swap(rhs); }
+}
@@ -0,0 +1,554 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   learned_map.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 17:41:26 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 17:41:26 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include "map.hpp"
+#include "vector.hpp"
+
+namespace ft
+{
+	// Learned map iterator.
+	// Walks the sorted key array and its parallel value array by index.
+
+	// Key			Type of keys.
+	// T			Type of mapped elements.
+	template <typename Key, typename T>
+	class learned_map_iterator
+	{
+		public:
+			typedef ft::pair<const Key&, const T&>			value_type;
+			typedef long int								difference_type;
+			typedef size_t									size_type;
+			typedef std::bidirectional_iterator_tag			iterator_category;
+			typedef value_type								reference;
+
+			// Holds the pair returned by operator-> for the duration of the expression.
+			struct pointer
+			{
+				value_type	m_pair;
+				pointer(const value_type& pair) : m_pair(pair) {}
+				const value_type* operator->() const { return &m_pair; }
+			};
+
+		private:
+			const Key*		m_keys;
+			const T*		m_values;
+			size_type		m_index;
+
+		public:
+
+// __ Constructors & Destructor
+
+			// Default.
+			learned_map_iterator(const Key* keys = 0, const T* values = 0, size_type index = 0) :
+				m_keys(keys), m_values(values), m_index(index) {}
+
+			// Copy.
+			learned_map_iterator(const learned_map_iterator& copy) :
+				m_keys(copy.m_keys), m_values(copy.m_values), m_index(copy.m_index) {}
+
+			// Destroy.
+			~learned_map_iterator() {}
+
+			// Operator=.
+			learned_map_iterator& operator=(const learned_map_iterator& assign)
+			{
+				if (this != &assign)
+				{
+					m_keys = assign.m_keys;
+					m_values = assign.m_values;
+					m_index = assign.m_index;
+				}
+				return (*this);
+			}
+
+// __ Getters
+
+			size_type getIndex() const { return m_index; }
+			const Key& key() const { return m_keys[m_index]; }
+			const T& value() const { return m_values[m_index]; }
+
+// __ Operators
+
+			reference operator*() const { return value_type(m_keys[m_index], m_values[m_index]); }
+			pointer operator->() const { return pointer(**this); }
+
+			learned_map_iterator& operator++()
+			{
+				++m_index;
+				return (*this);
+			}
+
+			learned_map_iterator operator++(int)
+			{
+				learned_map_iterator tmp(*this);
+				++(*this);
+				return (tmp);
+			}
+
+			learned_map_iterator& operator--()
+			{
+				--m_index;
+				return (*this);
+			}
+
+			learned_map_iterator operator--(int)
+			{
+				learned_map_iterator tmp(*this);
+				--(*this);
+				return (tmp);
+			}
+
+			bool operator==(const learned_map_iterator& it) const { return (it.m_index == m_index); }
+			bool operator!=(const learned_map_iterator& it) const { return (it.m_index != m_index); }
+	};
+
+	// Read-only index over integer keys, built once from an ft::map or a sorted
+	// ft::vector. Keys sit in one sorted array with the values in a parallel one. A
+	// two-level model predicts where a key is: a root line picks one of many segments,
+	// and the segment's own line, fitted by least squares to the keys it covers,
+	// predicts a position. The segment also stores how far its predictions were off
+	// for those keys, so a lookup ends with a binary search over that window only.
+	// Both lines have a non-negative slope, so a key that is not present still lands
+	// between its neighbours' windows and lower_bound stays exact.
+
+	//   key     		Integral type of keys, ordered by operator<.
+	//   T       	 	Type of elements.
+	template<
+		typename Key,
+		typename T >
+	class learned_map
+	{
+		public:
+
+			// Member Type.
+			typedef Key											key_type;
+			typedef T											mapped_type;
+			typedef ft::less<Key>								key_compare;
+			typedef size_t										size_type;
+			typedef long int									difference_type;
+
+			typedef ft::learned_map_iterator<Key, T>			iterator;
+			typedef ft::learned_map_iterator<Key, T>			const_iterator;
+			typedef typename iterator::value_type				value_type;
+
+		private:
+
+			// One leaf of the model, covering the keys at [begin, end). Positions are
+			// predicted as intercept + slope * (key - first).
+			struct segment
+			{
+				Key			first;
+				double		slope;
+				double		intercept;
+				size_type	begin;
+				size_type	end;
+				size_type	errorBelow;
+				size_type	errorAbove;
+			};
+
+			// Attributes.
+			Key*						m_keys;
+			T*							m_values;
+			size_type					m_size;
+			segment*					m_segments;
+			size_type					m_segmentCount;
+			double						m_rootSlope;
+			double						m_rootIntercept;
+			std::allocator<Key>			m_allocKey;
+			std::allocator<T>			m_allocValue;
+			std::allocator<segment>		m_allocSegment;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			learned_map() :
+			m_keys(0), m_values(0), m_size(0), m_segments(0), m_segmentCount(0),
+			m_rootSlope(0), m_rootIntercept(0) {}
+
+			// From a map, the content is copied and the map can be dropped afterwards.
+			// segments is the number of leaves of the model, 0 picks one per 32 keys. Like
+			// every constructor, a throwing copy gives back everything built so far.
+			template <typename Alloc, typename Balance, typename Augment>
+			explicit learned_map(const ft::map<Key, T, ft::less<Key>, Alloc, Balance, Augment>& src,
+			size_type segments = 0) :
+			m_keys(0), m_values(0), m_size(0), m_segments(0), m_segmentCount(0),
+			m_rootSlope(0), m_rootIntercept(0)
+			{
+				allocate(src.size());
+				try
+				{
+					typename ft::map<Key, T, ft::less<Key>, Alloc, Balance, Augment>::const_iterator it = src.begin();
+					for (; it != src.end(); ++it, ++m_size)
+						constructAt(m_size, it->first, it->second);
+					train(segments);
+				}
+				catch (...)
+				{
+					release(src.size());
+					throw ;
+				}
+			}
+
+			// From pairs sorted by strictly increasing key.
+			explicit learned_map(const ft::vector<ft::pair<Key, T> >& sorted, size_type segments = 0) :
+			m_keys(0), m_values(0), m_size(0), m_segments(0), m_segmentCount(0),
+			m_rootSlope(0), m_rootIntercept(0)
+			{
+				for (size_type i = 1; i < sorted.size(); ++i)
+					if (!(sorted[i - 1].first < sorted[i].first))
+						throw std::invalid_argument("learned_map: keys must be sorted and unique");
+				allocate(sorted.size());
+				try
+				{
+					for (; m_size < sorted.size(); ++m_size)
+						constructAt(m_size, sorted[m_size].first, sorted[m_size].second);
+					train(segments);
+				}
+				catch (...)
+				{
+					release(sorted.size());
+					throw ;
+				}
+			}
+
+			// Copy.
+			learned_map(const learned_map& other) :
+			m_keys(0), m_values(0), m_size(0), m_segments(0), m_segmentCount(0),
+			m_rootSlope(other.m_rootSlope), m_rootIntercept(other.m_rootIntercept)
+			{
+				allocate(other.m_size);
+				try
+				{
+					for (; m_size < other.m_size; ++m_size)
+						constructAt(m_size, other.m_keys[m_size], other.m_values[m_size]);
+					if (other.m_segmentCount)
+					{
+						m_segments = m_allocSegment.allocate(other.m_segmentCount);
+						for (; m_segmentCount < other.m_segmentCount; ++m_segmentCount)
+							m_segments[m_segmentCount] = other.m_segments[m_segmentCount];
+					}
+				}
+				catch (...)
+				{
+					release(other.m_size);
+					throw ;
+				}
+			}
+
+			// Operator=.
+			learned_map& operator=(const learned_map& other)
+			{
+				learned_map tmp(other);
+				this->swap(tmp);
+				return *this;
+			}
+
+			// Destroy.
+			~learned_map() { release(m_size); }
+
+// __ Iterators
+
+			const_iterator begin() const	{ return const_iterator(m_keys, m_values, 0); }
+			const_iterator end() const		{ return const_iterator(m_keys, m_values, m_size); }
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return m_size == 0; }
+
+			// Size.
+			size_type size() const 		{ return m_size; }
+
+			// Widest window a lookup may have to search, in elements.
+			size_type max_error() const
+			{
+				size_type widest = 0;
+				for (size_type i = 0; i < m_segmentCount; ++i)
+					if (m_segments[i].errorBelow + m_segments[i].errorAbove > widest)
+						widest = m_segments[i].errorBelow + m_segments[i].errorAbove;
+				return widest;
+			}
+
+// __ Element Access
+
+			// At.
+			const T& at(const Key& key) const
+			{
+				size_type i = lowerBoundIndex(key);
+				if (i == m_size || key < m_keys[i])
+					throw std::out_of_range("learned_map::at: key not found");
+				return m_values[i];
+			}
+
+// __ Modifiers
+
+			// Swaps the content of this one.
+			void swap(learned_map& other)
+			{
+				swap(m_keys, other.m_keys);
+				swap(m_values, other.m_values);
+				swap(m_size, other.m_size);
+				swap(m_segments, other.m_segments);
+				swap(m_segmentCount, other.m_segmentCount);
+				swap(m_rootSlope, other.m_rootSlope);
+				swap(m_rootIntercept, other.m_rootIntercept);
+			}
+
+// __ Observers
+
+			// Return key comparison object.
+			key_compare key_comp() const { return key_compare(); }
+
+// __ Operations
+
+			// Searches the index for an element.
+			const_iterator find(const Key& key) const
+			{
+				size_type i = lowerBoundIndex(key);
+				if (i == m_size || key < m_keys[i])
+					return end();
+				return const_iterator(m_keys, m_values, i);
+			}
+
+			// Count elements with a specific key.
+			size_type count(const Key& key) const { return find(key) != end(); }
+
+			// Return the element whose key is not considered to go before key.
+			const_iterator lower_bound(const Key& key) const
+			{
+				return const_iterator(m_keys, m_values, lowerBoundIndex(key));
+			}
+
+			// Return the element whose key is considered to go after key.
+			const_iterator upper_bound(const Key& key) const
+			{
+				size_type i = lowerBoundIndex(key);
+				if (i < m_size && !(key < m_keys[i]))
+					++i;
+				return const_iterator(m_keys, m_values, i);
+			}
+
+			// Returns the bounds of a range.
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+		private:
+
+			// Swap.
+			template <typename U>
+			void swap(U& a, U& b)
+			{
+				U tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+			void allocate(size_type n)
+			{
+				if (n == 0)
+					return ;
+				m_keys = m_allocKey.allocate(n);
+				try
+				{
+					m_values = m_allocValue.allocate(n);
+				}
+				catch (...)
+				{
+					m_allocKey.deallocate(m_keys, n);
+					m_keys = 0;
+					throw ;
+				}
+			}
+
+			// Builds one element, the key is destroyed again if the value throws.
+			void constructAt(size_type i, const Key& key, const T& value)
+			{
+				m_allocKey.construct(m_keys + i, key);
+				try
+				{
+					m_allocValue.construct(m_values + i, value);
+				}
+				catch (...)
+				{
+					m_allocKey.destroy(m_keys + i);
+					throw ;
+				}
+			}
+
+			// Destroys the m_size elements and frees arrays sized for capacity of them.
+			void release(size_type capacity)
+			{
+				for (size_type i = 0; i < m_size; ++i)
+				{
+					m_allocKey.destroy(m_keys + i);
+					m_allocValue.destroy(m_values + i);
+				}
+				if (m_keys)
+				{
+					m_allocKey.deallocate(m_keys, capacity);
+					m_allocValue.deallocate(m_values, capacity);
+				}
+				if (m_segments)
+					m_allocSegment.deallocate(m_segments, m_segmentCount);
+				m_keys = 0;
+				m_values = 0;
+				m_segments = 0;
+				m_size = 0;
+				m_segmentCount = 0;
+			}
+
+// __ Model
+
+			// Distance from base to a key not below it, exact in the integers before it
+			// is rounded to a double, so it never decreases as the key grows.
+			static double offset(const Key& key, const Key& base)
+			{
+				return static_cast<double>(static_cast<uint64_t>(key) - static_cast<uint64_t>(base));
+			}
+
+			// Least-squares line through (key - base, scale * position) for keys [lo, hi).
+			void fitLine(size_type lo, size_type hi, double scale, double& slope, double& intercept) const
+			{
+				double n = static_cast<double>(hi - lo);
+				double meanX = 0;
+				double meanY = 0;
+				for (size_type i = lo; i < hi; ++i)
+				{
+					meanX += offset(m_keys[i], m_keys[lo]);
+					meanY += scale * i;
+				}
+				meanX /= n;
+				meanY /= n;
+				double sxx = 0;
+				double sxy = 0;
+				for (size_type i = lo; i < hi; ++i)
+				{
+					double dx = offset(m_keys[i], m_keys[lo]) - meanX;
+					sxx += dx * dx;
+					sxy += dx * (scale * i - meanY);
+				}
+				slope = sxx > 0 && sxy > 0 ? sxy / sxx : 0;
+				intercept = meanY - slope * meanX;
+			}
+
+			// The root line spreads the keys over the segments; it only ever moves a
+			// larger key to the same or a later segment.
+			size_type segmentOf(const Key& key) const
+			{
+				double at = m_rootIntercept + m_rootSlope * offset(key, m_keys[0]);
+				if (!(at > 0))
+					return 0;
+				if (at >= static_cast<double>(m_segmentCount - 1))
+					return m_segmentCount - 1;
+				return static_cast<size_type>(at);
+			}
+
+			double predict(const segment& seg, const Key& key) const
+			{
+				return seg.intercept + seg.slope * offset(key, seg.first);
+			}
+
+			// Fits the root, hands every key to its segment, then fits each segment and
+			// records the worst under- and over-prediction among its own keys.
+			void train(size_type segments)
+			{
+				if (m_size == 0)
+					return ;
+				m_segmentCount = segments ? segments : (m_size + 31) / 32;
+				fitLine(0, m_size, static_cast<double>(m_segmentCount) / m_size, m_rootSlope, m_rootIntercept);
+				m_segments = m_allocSegment.allocate(m_segmentCount);
+				size_type i = 0;
+				for (size_type s = 0; s < m_segmentCount; ++s)
+				{
+					segment& seg = m_segments[s];
+					seg.begin = i;
+					while (i < m_size && segmentOf(m_keys[i]) == s)
+						++i;
+					seg.end = i;
+					seg.first = seg.begin < seg.end ? m_keys[seg.begin] : Key();
+					seg.slope = 0;
+					seg.intercept = static_cast<double>(seg.begin);
+					seg.errorBelow = 0;
+					seg.errorAbove = 0;
+					if (seg.begin == seg.end)
+						continue ;
+					fitLine(seg.begin, seg.end, 1.0, seg.slope, seg.intercept);
+					double below = 0;
+					double above = 0;
+					for (size_type k = seg.begin; k < seg.end; ++k)
+					{
+						double miss = static_cast<double>(k) - predict(seg, m_keys[k]);
+						if (miss > above)
+							above = miss;
+						if (-miss > below)
+							below = -miss;
+					}
+					seg.errorBelow = static_cast<size_type>(below) + 1;
+					seg.errorAbove = static_cast<size_type>(above) + 1;
+				}
+			}
+
+			// Keys outside a segment's own range have their answer at one of its ends.
+			// Inside, the answer is within the recorded error of the prediction, give or
+			// take the rounding already counted in the +1 of each bound.
+			size_type lowerBoundIndex(const Key& key) const
+			{
+				if (m_size == 0 || !(m_keys[0] < key))
+					return 0;
+				if (m_keys[m_size - 1] < key)
+					return m_size;
+				const segment& seg = m_segments[segmentOf(key)];
+				if (seg.begin == seg.end || !(seg.first < key))
+					return seg.begin;
+				if (m_keys[seg.end - 1] < key)
+					return seg.end;
+				double at = predict(seg, key);
+				size_type guess = at > static_cast<double>(seg.begin) ? static_cast<size_type>(at) : seg.begin;
+				size_type lo = guess > seg.begin + seg.errorBelow ? guess - seg.errorBelow : seg.begin;
+				size_type hi = guess + seg.errorAbove + 1 < seg.end ? guess + seg.errorAbove + 1 : seg.end;
+				if (lo > hi)
+					lo = hi;
+				return searchWindow(lo, hi, key);
+			}
+
+			// Branchless binary search of [lo, hi): halves the window without
+			// branching on the comparison, then settles the last element.
+			size_type searchWindow(size_type lo, size_type hi, const Key& key) const
+			{
+				const Key* base = m_keys + lo;
+				size_type len = hi - lo;
+				if (len == 0)
+					return lo;
+				while (len > 1)
+				{
+					size_type half = len / 2;
+					base += base[half] < key ? half : 0;
+					len -= half;
+				}
+				return (base - m_keys) + (*base < key);
+			}
+	};
+
+	// Non member functions
+	template <typename Key, typename T>
+	void swap(ft::learned_map<Key, T> &lhs, ft::learned_map<Key, T> &rhs)
+	{ lhs.swap(rhs); }
+}
@@ -13,18 +13,107 @@
 #pragma once
 
 #include <iostream>
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <new>
+#include <exception>
+#include <thread>
 #include "map_iterator.hpp"
+#include "vector.hpp"
 
 namespace ft
 {
+	// Augmentations.
+	// An augmentation is a monoid over the mapped values that every node folds over its
+	// subtree, which lets ft::map::aggregate answer range queries in O(log n):
+	//   value_type				Type of the summaries.
+	//   identity()				Summary of no element.
+	//   lift(mapped)			Summary of one element.
+	//   combine(a, b)			Associative, a summarizes keys ordered before b's.
+
+	// Sum of the mapped values.
+	template <typename T>
+	struct sum_augment
+	{
+		typedef T	value_type;
+		static T identity() { return T(); }
+		static T lift(const T& mapped) { return mapped; }
+		static T combine(const T& a, const T& b) { return a + b; }
+	};
+
+	// Smallest mapped value, identity is the type's maximum.
+	template <typename T>
+	struct min_augment
+	{
+		typedef T	value_type;
+		static T identity() { return std::numeric_limits<T>::max(); }
+		static T lift(const T& mapped) { return mapped; }
+		static T combine(const T& a, const T& b) { return b < a ? b : a; }
+	};
+
+	// Largest mapped value, identity is the type's lowest. Keyed by interval start with
+	// the end as mapped value, this is the max-endpoint of an interval tree.
+	template <typename T>
+	struct max_augment
+	{
+		typedef T	value_type;
+		static T identity() { return std::numeric_limits<T>::lowest(); }
+		static T lift(const T& mapped) { return mapped; }
+		static T combine(const T& a, const T& b) { return a < b ? b : a; }
+	};
+
+	// Keeps node summaries up to date, does nothing for ft::no_augment.
+	template <typename Augment>
+	struct augment_ops
+	{
+		// Recomputes a node's summary from its children's.
+		template <typename Node>
+		static void pull(Node* node, Node* m_lastElem)
+		{
+			typename Augment::value_type summary = Augment::lift(node->content.second);
+			if (!Node::isNil(node->left, m_lastElem))
+				summary = Augment::combine(node->left->summary, summary);
+			if (!Node::isNil(node->right, m_lastElem))
+				summary = Augment::combine(summary, node->right->summary);
+			node->summary = summary;
+		}
+
+		// Pulls every node from this one up to the root.
+		template <typename Node>
+		static void pullPath(Node* node, Node* m_lastElem)
+		{
+			for (; !Node::isNil(node, m_lastElem); node = node->parent)
+				pull(node, m_lastElem);
+		}
+	};
+
+	template <>
+	struct augment_ops<ft::no_augment>
+	{
+		template <typename Node>
+		static void pull(Node*, Node*) {}
+
+		template <typename Node>
+		static void pullPath(Node*, Node*) {}
+	};
+
 	// Node
-	template<typename T>
-	struct Node
+	template<typename T, typename Augment>
+	struct Node : ft::prefix_slot<typename ft::key_prefix<typename T::first_type>::type>
 	{
 		T							content;
 		Node*						parent;
 		Node*						left;
 		Node*						right;
+		int							balanceInfo;
+		typename Augment::value_type	summary;
+
+		// Leaves point to the sentinel, only the root's parent may be null.
+		static bool isNil(Node* node, Node* m_lastElem)
+		{
+			return node == 0 || node == m_lastElem;
+		}
 
 		// Searches for the element with the highest key in the tree.
 		static Node* searchMaxNode(Node *root, Node* m_lastElem)
@@ -91,20 +180,287 @@ namespace ft
 			}
 			return node;
 		}
+
+		// LEFT ROTATION
+		// Does a left rotation between a node and his right child. The right child will go up and take
+		// the position of this node; and this node will become the left child of the node going up.
+		// Both nodes get their summary recomputed, lower one first.
+		static Node* rotateLeft(Node* x, Node*& root, Node* m_lastElem)
+		{
+			Node* y = x->right;
+			x->right = y->left;
+			if (!isNil(y->left, m_lastElem))
+				y->left->parent = x;
+			y->parent = x->parent;
+			if (isNil(x->parent, m_lastElem))
+				root = y;
+			else if (x == x->parent->left)
+				x->parent->left = y;
+			else
+				x->parent->right = y;
+			y->left = x;
+			x->parent = y;
+			augment_ops<Augment>::pull(x, m_lastElem);
+			augment_ops<Augment>::pull(y, m_lastElem);
+			return y;
+		}
+
+		// RIGHT ROTATION
+		// Does a right rotation between a node and his left child. The left child will go up and take 
+		// the position of this node, and this node will become the right child of the node going up.
+		// Both nodes get their summary recomputed, lower one first.
+		static Node* rotateRight(Node* x, Node*& root, Node* m_lastElem)
+		{
+			Node* y = x->left;
+			x->left = y->right;
+			if (!isNil(y->right, m_lastElem))
+				y->right->parent = x;
+			y->parent = x->parent;
+			if (isNil(x->parent, m_lastElem))
+				root = y;
+			else if (x == x->parent->right)
+				x->parent->right = y;
+			else
+				x->parent->left = y;
+			y->right = x;
+			x->parent = y;
+			augment_ops<Augment>::pull(x, m_lastElem);
+			augment_ops<Augment>::pull(y, m_lastElem);
+			return y;
+		}
+	};
+
+	// Balancing policies.
+	// A policy keeps its bookkeeping in Node::balanceInfo and restores its invariant after
+	// each insertion or removal, using the rotations shared by Node. The map hands it the
+	// node that was linked in, or the child that took the place of the removed node (maybe
+	// the sentinel) together with that child's parent.
+
+	// AVL: balanceInfo is the height of the subtree. Keeps lookups the shallowest, but an
+	// erase may rotate at every level on the way back up.
+	struct avl_balance
+	{
+		template <typename Node>
+		static int height(Node* node, Node* m_lastElem)
+		{
+			return Node::isNil(node, m_lastElem) ? 0 : node->balanceInfo;
+		}
+
+		template <typename Node>
+		static void updateHeight(Node* node, Node* m_lastElem)
+		{
+			int left = height(node->left, m_lastElem);
+			int right = height(node->right, m_lastElem);
+			node->balanceInfo = 1 + (left > right ? left : right);
+		}
+
+		template <typename Node>
+		static void initNode(Node* node) { node->balanceInfo = 1; }
+
+		// Node built bottom-up by bulk_load, its children are already final.
+		template <typename Node>
+		static void initBuiltNode(Node* node, size_t, size_t, Node* m_lastElem)
+		{
+			updateHeight(node, m_lastElem);
+		}
+
+		template <typename Node>
+		static void afterInsert(Node* node, Node*& root, Node* m_lastElem)
+		{
+			retrace(node->parent, root, m_lastElem);
+		}
+
+		template <typename Node>
+		static void afterErase(Node*, Node* parent, int, Node*& root, Node* m_lastElem)
+		{
+			retrace(parent, root, m_lastElem);
+		}
+
+		// Starts from a node in the AVL tree, and will check for this node and all the parent's node
+		// if their balance (height of left and right subtree) is correct. If not, a rotation
+		// (left or right) around the unbalanced node will occured in order to restore tree's balance.
+		// Stops once a subtree is back at the height it had before the update.
+		template <typename Node>
+		static void retrace(Node* node, Node*& root, Node* m_lastElem)
+		{
+			while (!Node::isNil(node, m_lastElem))
+			{
+				int before = node->balanceInfo;
+				updateHeight(node, m_lastElem);
+				int balance = height(node->left, m_lastElem) - height(node->right, m_lastElem);
+				if (balance > 1)
+				{
+					if (height(node->left->left, m_lastElem) < height(node->left->right, m_lastElem))
+						rotateLeft(node->left, root, m_lastElem);
+					node = rotateRight(node, root, m_lastElem);
+				}
+				else if (balance < -1)
+				{
+					if (height(node->right->right, m_lastElem) < height(node->right->left, m_lastElem))
+						rotateRight(node->right, root, m_lastElem);
+					node = rotateLeft(node, root, m_lastElem);
+				}
+				if (node->balanceInfo == before)
+					break;
+				node = node->parent;
+			}
+		}
+
+		template <typename Node>
+		static Node* rotateLeft(Node* x, Node*& root, Node* m_lastElem)
+		{
+			Node* y = Node::rotateLeft(x, root, m_lastElem);
+			updateHeight(x, m_lastElem);
+			updateHeight(y, m_lastElem);
+			return y;
+		}
+
+		template <typename Node>
+		static Node* rotateRight(Node* x, Node*& root, Node* m_lastElem)
+		{
+			Node* y = Node::rotateRight(x, root, m_lastElem);
+			updateHeight(x, m_lastElem);
+			updateHeight(y, m_lastElem);
+			return y;
+		}
+	};
+
+	// Red-black: balanceInfo is the node's color, the sentinel counts as black. The tree
+	// may be up to twice as deep as an AVL one, but any update needs at most three
+	// rotations, which suits maps that insert and erase all the time.
+	struct red_black_balance
+	{
+		enum { red = 0, black = 1 };
+
+		template <typename Node>
+		static bool isRed(Node* node, Node* m_lastElem)
+		{
+			return !Node::isNil(node, m_lastElem) && node->balanceInfo == red;
+		}
+
+		template <typename Node>
+		static void initNode(Node* node) { node->balanceInfo = red; }
+
+		// bulk_load builds a tree whose levels are all full but the deepest one, so
+		// painting that level red gives every path the same number of black nodes.
+		template <typename Node>
+		static void initBuiltNode(Node* node, size_t depth, size_t maxDepth, Node*)
+		{
+			node->balanceInfo = (depth == maxDepth && depth > 0) ? red : black;
+		}
+
+		template <typename Node>
+		static void afterInsert(Node* node, Node*& root, Node* m_lastElem)
+		{
+			while (node != root && isRed(node->parent, m_lastElem))
+			{
+				Node* parent = node->parent;
+				Node* grandParent = parent->parent;
+				bool leftSide = parent == grandParent->left;
+				Node* uncle = leftSide ? grandParent->right : grandParent->left;
+				if (isRed(uncle, m_lastElem))
+				{
+					parent->balanceInfo = black;
+					uncle->balanceInfo = black;
+					grandParent->balanceInfo = red;
+					node = grandParent;
+					continue ;
+				}
+				if (node == (leftSide ? parent->right : parent->left))
+				{
+					node = parent;
+					parent = leftSide ? Node::rotateLeft(node, root, m_lastElem)
+						: Node::rotateRight(node, root, m_lastElem);
+				}
+				parent->balanceInfo = black;
+				grandParent->balanceInfo = red;
+				if (leftSide)
+					Node::rotateRight(grandParent, root, m_lastElem);
+				else
+					Node::rotateLeft(grandParent, root, m_lastElem);
+			}
+			root->balanceInfo = black;
+		}
+
+		// Only removing a black node breaks the black height; the child that replaced it
+		// then carries an extra black that is pushed up or absorbed by a rotation.
+		template <typename Node>
+		static void afterErase(Node* node, Node* parent, int removedInfo, Node*& root, Node* m_lastElem)
+		{
+			if (removedInfo != black)
+				return ;
+			while (node != root && !isRed(node, m_lastElem))
+			{
+				bool leftSide = node == parent->left;
+				Node* sibling = leftSide ? parent->right : parent->left;
+				if (isRed(sibling, m_lastElem))
+				{
+					sibling->balanceInfo = black;
+					parent->balanceInfo = red;
+					if (leftSide)
+						Node::rotateLeft(parent, root, m_lastElem);
+					else
+						Node::rotateRight(parent, root, m_lastElem);
+					sibling = leftSide ? parent->right : parent->left;
+				}
+				Node* nearNephew = leftSide ? sibling->left : sibling->right;
+				Node* farNephew = leftSide ? sibling->right : sibling->left;
+				if (!isRed(nearNephew, m_lastElem) && !isRed(farNephew, m_lastElem))
+				{
+					sibling->balanceInfo = red;
+					node = parent;
+					parent = node->parent;
+					continue ;
+				}
+				if (!isRed(farNephew, m_lastElem))
+				{
+					nearNephew->balanceInfo = black;
+					sibling->balanceInfo = red;
+					farNephew = sibling;
+					sibling = leftSide ? Node::rotateRight(sibling, root, m_lastElem)
+						: Node::rotateLeft(sibling, root, m_lastElem);
+				}
+				sibling->balanceInfo = parent->balanceInfo;
+				parent->balanceInfo = black;
+				farNephew->balanceInfo = black;
+				if (leftSide)
+					Node::rotateLeft(parent, root, m_lastElem);
+				else
+					Node::rotateRight(parent, root, m_lastElem);
+				node = root;
+			}
+			if (!Node::isNil(node, m_lastElem))
+				node->balanceInfo = black;
+		}
 	};
 
+	// Which element bulk_load keeps when the input holds the same key more than once.
+	enum duplicate_policy { keep_first, keep_last };
+
 	//   key     		Type of keys.
 	//   T       	 	Type of elements.
 	//   Compare  		Comparison object used to sort the binary tree.
 	//   Allocator		Object used to manage the vector' storage.
+	//   Balance		Balancing policy, ft::avl_balance or ft::red_black_balance.
+	//   Augment		Summary kept in every node for aggregate(), e.g. ft::sum_augment<T>.
+	//					Values are then read-only through references and change through
+	//					insert_or_assign() or update().
 	template<
 		typename Key,
 		typename T,
 		typename Compare = ft::less<Key>,
-		typename Allocator = std::allocator<ft::pair<const Key, T> > >
+		typename Allocator = std::allocator<ft::pair<const Key, T> >,
+		typename Balance = ft::avl_balance,
+		typename Augment = ft::no_augment >
 	class map
 	{
-			typedef ft::Node<ft::pair<const Key, T> >	Node;
+			typedef ft::Node<ft::pair<const Key, T>, Augment>	Node;
+			// Nodes and the pool's slab list come from Allocator too, rebound.
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<Node>	node_allocator;
+			typedef ft::pair<Node*, size_t>													slab_entry;
+			typedef typename std::allocator_traits<Allocator>::template rebind_alloc<slab_entry>	slab_allocator;
+			typedef ft::key_prefix<Key>							prefix_type;
+			typedef typename prefix_type::type					prefix;
 
 		public:
 
@@ -122,9 +478,10 @@ namespace ft
 			typedef const T&							const_reference;
 			typedef T*									pointer;
 			typedef const T*							const_pointer;
+			typedef typename Augment::value_type		summary_type;
 
-			typedef typename ft::map_iterator<value_type, false>		iterator;
-			typedef typename ft::map_iterator<value_type, true>			const_iterator;
+			typedef typename ft::map_iterator<value_type, false, Augment>	iterator;
+			typedef typename ft::map_iterator<value_type, true, Augment>	const_iterator;
 			typedef typename ft::rev_map_iterator<iterator>				reverse_iterator;
 			typedef typename ft::rev_map_iterator<const_iterator>		const_reverse_iterator;
 		public:
@@ -142,7 +499,7 @@ namespace ft
 					typedef value_type	second_argument_type;
 					bool operator() (const value_type &a, const value_type &b) const
 					{
-						return comp(a.first, b.first);
+						return ft::key_order<Compare, Key>::less(comp, a.first, b.first);
 					}
 			};
 
@@ -154,7 +511,17 @@ namespace ft
 			size_type				m_size;
 			allocator_type			m_allocPair;
 			key_compare				m_comp;
-			std::allocator<Node>	m_allocNode;
+			node_allocator			m_allocNode;
+			mutable Node*			m_finger;
+			bool					m_fingerSearch;
+			Node*					m_freeNodes;
+			size_type				m_freeCount;
+			ft::vector<slab_entry, slab_allocator>	m_slabs;
+			bool					m_fixedCapacity;
+			Node*					m_compactSlab;
+			size_type				m_compactSize;
+			size_type				m_compactUsed;
+			Node*					m_compactNext;
 
 // __ Constructors and Destructor
 
@@ -162,7 +529,9 @@ namespace ft
 
 			// Default.
 			explicit map(const Compare& comp = Compare(),
-			const Allocator& alloc = Allocator()) : m_size(0), m_allocPair(alloc), m_comp(comp)
+			const Allocator& alloc = Allocator()) : m_size(0), m_allocPair(alloc), m_comp(comp),
+			m_allocNode(alloc), m_finger(0), m_fingerSearch(false), m_freeNodes(0), m_freeCount(0),
+			m_slabs(slab_allocator(alloc)), m_fixedCapacity(false), m_compactSlab(0), m_compactSize(0), m_compactUsed(0), m_compactNext(0)
 			{
 				m_lastElem = createNode(ft::pair<const Key, T>());
 				m_lastElem->left = 0;
@@ -175,7 +544,10 @@ namespace ft
 			template<typename InputIterator>map(InputIterator first, InputIterator last,
 			const Compare& comp = Compare(), const Allocator& alloc = Allocator(),
 			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) :
-			m_size(0), m_allocPair(alloc), m_comp(comp)
+			m_size(0), m_allocPair(alloc), m_comp(comp), m_allocNode(alloc), m_finger(0),
+			m_fingerSearch(false), m_freeNodes(0), m_freeCount(0), m_slabs(slab_allocator(alloc)),
+			m_fixedCapacity(false),
+			m_compactSlab(0), m_compactSize(0), m_compactUsed(0), m_compactNext(0)
 			{
 				m_lastElem = createNode(ft::pair<const Key, T>());
 				m_lastElem->left = m_lastElem;
@@ -186,9 +558,16 @@ namespace ft
 					insert(*first);
 			}
 
-			// Copy.
-			map(const map& other) : 
-			m_size(0), m_allocPair(other.m_allocPair), m_comp(other.m_comp), m_allocNode(other.m_allocNode)
+			// Copy, with the allocator other's selects for a copy: a polymorphic_allocator
+			// gives the default resource, not other's arena.
+			map(const map& other) :
+			map(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_allocPair)) {}
+
+			// Copy into storage from alloc.
+			map(const map& other, const Allocator& alloc) :
+			m_size(0), m_allocPair(alloc), m_comp(other.m_comp), m_allocNode(alloc),
+			m_finger(0), m_fingerSearch(other.m_fingerSearch), m_freeNodes(0), m_freeCount(0),
+			m_slabs(slab_allocator(alloc)), m_fixedCapacity(false), m_compactSlab(0), m_compactSize(0), m_compactUsed(0), m_compactNext(0)
 			{
 				m_lastElem = createNode(ft::pair<const Key, T>());
 				m_lastElem->left = m_lastElem;
@@ -199,10 +578,14 @@ namespace ft
 					insert(*it);
 			}
 
-			// Operator=.
+			// Operator=. Our allocator stays unless it propagates on copy assignment, so a map
+			// assigned from one in a per-request arena copies into its own storage.
 			map &operator=(const map &other)
 			{
-				map tmp(other);
+				if (this == &other)
+					return *this;
+				map tmp(other, std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value
+					? other.m_allocPair : m_allocPair);
 				this->swap(tmp);
 				return *this;
 			}
@@ -211,7 +594,10 @@ namespace ft
 			~map()
 			{
 				clear();
-				deallocateNode(m_lastElem);
+				endCompaction();
+				destroyNode(m_lastElem);
+				m_allocNode.deallocate(m_lastElem, 1);
+				releaseFreeNodes();
 			}
 
 // __ Getters
@@ -243,10 +629,44 @@ namespace ft
 				return m_allocPair.max_size();
 			}
 
+			// Number of elements the map can hold without calling the allocator.
+			size_type capacity() const	{ return m_size + m_freeCount; }
+
+			// Allocates node storage for at least n elements in one block. Once a map has
+			// reserved, erased nodes are kept for reuse instead of being freed, so inserts
+			// stop calling the allocator after warm-up.
+			void reserve(size_type n)
+			{
+				if (n > max_size())
+					throw std::length_error("map::reserve: too many elements");
+				if (n <= capacity())
+					return ;
+				size_type count = n - capacity();
+				Node* slab = m_allocNode.allocate(count);
+				m_slabs.push_back(ft::pair<Node*, size_type>(slab, count));
+				for (size_type i = count; i > 0; --i)
+					pushFreeNode(slab + i - 1);
+			}
+
+			// Gives back the unused node storage that can be given back: reserved blocks
+			// with no element left in them and spare nodes allocated one by one. Blocks
+			// still partly in use stay, with their free nodes.
+			void shrink_to_fit()
+			{
+				releaseFreeNodes();
+			}
+
+			// In fixed-capacity mode an insert that would need a new node throws
+			// std::length_error instead of allocating, leaving the map unchanged.
+			void fixed_capacity(bool enable)	{ m_fixedCapacity = enable; }
+			bool fixed_capacity() const			{ return m_fixedCapacity; }
+
 // __ Element Access
 
-			// At
-			T& at(const Key& key)
+			// At, for maps without summaries: an augmented map only reads through at().
+			template <typename A = Augment>
+			typename ft::enable_if<ft::is_same<A, ft::no_augment>::value, T&>::type
+			at(const Key& key)
 			{
 				iterator it;
 				it = this->find(key);
@@ -258,21 +678,23 @@ namespace ft
 			// At (const)
 			const T& at(const Key& key) const
 			{
-				iterator it;
+				const_iterator it;
 				it = this->find(key);
 				if (it == this->end())
 					throw std::out_of_range("map::at: key not found");
 				return (it->second);
 			}
 
-			// Operator []
-			T& operator[](const Key& k)
+			// Operator [], for maps without summaries: an augmented map writes through update().
+			template <typename A = Augment>
+			typename ft::enable_if<ft::is_same<A, ft::no_augment>::value, T&>::type
+			operator[](const Key& k)
 			{
-				Node* tmp = searchNode(m_root, k);
-				if (tmp)
-					return tmp->content.second;
-				value_type val = ft::make_pair<Key, T>(k, T());
-				return insertNode(m_root, val)->content.second;
+				Node* start = descentStart(k);
+				Node* tmp = searchNode(start, k);
+				if (!tmp)
+					tmp = insertNode(start, ft::make_pair<Key, T>(k, T()));
+				return noteAccess(tmp)->content.second;
 			}
 
 // __ Modifiers
@@ -280,10 +702,11 @@ namespace ft
 			// Insert one element.
 			ft::pair<iterator, bool> insert (const value_type& val)
 			{
-				Node* elemIsPresent = searchNode(m_root, val.first);
+				Node* start = descentStart(val.first);
+				Node* elemIsPresent = searchNode(start, val.first);
 				if (elemIsPresent && elemIsPresent != m_lastElem)
-					return ft::pair<iterator, bool>(iterator(elemIsPresent, m_lastElem), false);
-				return (ft::pair<iterator, bool>(iterator(insertNode(m_root, val), m_lastElem), true));
+					return ft::pair<iterator, bool>(iterator(noteAccess(elemIsPresent), m_lastElem), false);
+				return (ft::pair<iterator, bool>(iterator(noteAccess(insertNode(start, val)), m_lastElem), true));
 			}
 
 			// Insert one element starting from a certain position.
@@ -320,6 +743,43 @@ namespace ft
 					insert(*first++);
 			}
 
+			// Inserts the element, or assigns its value if the key is present, keeping the
+			// summaries of an augmented map up to date.
+			ft::pair<iterator, bool> insert_or_assign(const Key& k, const T& obj)
+			{
+				ft::pair<iterator, bool> res = insert(value_type(k, obj));
+				if (!res.second)
+				{
+					res.first.getNode()->content.second = obj;
+					augment_ops<Augment>::pullPath(res.first.getNode(), m_lastElem);
+				}
+				return res;
+			}
+
+			// Calls fn on the value of k, inserted as T() if missing, then recomputes the
+			// summaries above it, even when fn throws. The way to change a value in place
+			// in an augmented map, whose references are read-only.
+			template <typename Fn>
+			iterator update(const Key& k, Fn fn)
+			{
+				Node* start = descentStart(k);
+				Node* node = searchNode(start, k);
+				if (!node)
+					node = insertNode(start, ft::make_pair<Key, T>(k, T()));
+				noteAccess(node);
+				try
+				{
+					fn(node->content.second);
+				}
+				catch (...)
+				{
+					augment_ops<Augment>::pullPath(node, m_lastElem);
+					throw;
+				}
+				augment_ops<Augment>::pullPath(node, m_lastElem);
+				return iterator(node, m_lastElem);
+			}
+
 			// Removes one element.
 			void erase (iterator position)
 			{
@@ -352,11 +812,122 @@ namespace ft
 				swap(m_comp, a.m_comp);
 				swap(m_allocPair, a.m_allocPair);
 				swap(m_allocNode, a.m_allocNode);
+				swap(m_finger, a.m_finger);
+				swap(m_fingerSearch, a.m_fingerSearch);
+				swap(m_freeNodes, a.m_freeNodes);
+				swap(m_freeCount, a.m_freeCount);
+				m_slabs.swap(a.m_slabs);
+				swap(m_fixedCapacity, a.m_fixedCapacity);
+				swap(m_compactSlab, a.m_compactSlab);
+				swap(m_compactSize, a.m_compactSize);
+				swap(m_compactUsed, a.m_compactUsed);
+				swap(m_compactNext, a.m_compactNext);
 			}
 
 			// Removes all elements.
 			void clear() { erase(begin(), end()); }
 
+			// Replaces the content with the elements of an unsorted range. The range is sorted
+			// on up to `threads` threads, at most 64, duplicate keys are dropped according to `policy`
+			// (first or last in input order wins) and the tree is built bottom-up, already
+			// balanced, with the top subtrees constructed in parallel. An exception from a
+			// worker, a copy or the comparator, is rethrown here once every thread is joined:
+			// the map is unchanged if it came from sorting, empty if from building.
+			template <typename ForwardIterator>
+			void bulk_load(ForwardIterator first, ForwardIterator last, unsigned threads = 1,
+			duplicate_policy policy = keep_first,
+			typename ft::enable_if<!ft::is_integral<ForwardIterator>::value>::type* = 0)
+			{
+				if (threads == 0)
+					threads = 1;
+				else if (threads > 64)
+					threads = 64;
+				ft::vector<ForwardIterator> items;
+				items.reserve(ft::distance(first, last));
+				for (; first != last; ++first)
+					items.push_back(first);
+				if (items.empty())
+					return clear();
+				parallelSort(items, threads);
+				size_type count = dropDuplicates(items, policy);
+				if (m_fixedCapacity && count > m_freeCount + m_size)
+					throw std::length_error("map::bulk_load: fixed capacity exhausted");
+				clear();
+				size_type spawnDepth = 0;
+				while ((static_cast<size_type>(1) << spawnDepth) < threads)
+					++spawnDepth;
+				size_type maxDepth = 0;
+				while ((count >> (maxDepth + 1)) > 0)
+					++maxDepth;
+				ft::vector<Node*> slots(count, 0);
+				ft::vector<char> built(count, 0);
+				try
+				{
+					for (size_type i = 0; i < count; ++i)
+						slots[i] = acquireNode();
+					m_root = buildSubtree(items.data(), slots.data(), built.data(), 0, count, m_lastElem,
+						0, maxDepth, spawnDepth);
+				}
+				catch (...)
+				{
+					for (size_type i = 0; i < count && slots[i]; ++i)
+					{
+						if (built[i])
+							destroyNode(slots[i]);
+						releaseNode(slots[i]);
+					}
+					throw ;
+				}
+				m_lastElem->parent = m_root;
+				m_size = count;
+			}
+
+// __ Compaction
+
+			// Moves every node into one freshly allocated block, in key order, so that
+			// iteration walks memory forwards and neighbouring keys share cache lines. The
+			// block is sized for the current elements and the old storage is then released
+			// like shrink_to_fit does, so reserve() again for spare room. The map pools its
+			// nodes from then on. A step-wise compaction under way is restarted from the
+			// first key. Iterators, pointers and references to elements are invalidated.
+			// Elements are copy-constructed into the block, so compaction needs a copyable
+			// value_type; a throwing copy stops it with every element still in the map.
+			void compact()
+			{
+				endCompaction();
+				while (!compact_step(capacity() + 1))
+					;
+			}
+
+			// Same, a bounded number of nodes at a time: relocates at most n nodes and
+			// returns true once compaction is over. The map stays fully usable between
+			// steps; elements inserted behind the point reached are left where they are,
+			// and each step invalidates iterators like compact() does.
+			bool compact_step(size_type n)
+			{
+				if (!m_compactSlab)
+				{
+					if (m_size == 0)
+						return true;
+					m_compactSize = m_size;
+					m_compactSlab = m_allocNode.allocate(m_compactSize);
+					m_compactUsed = 0;
+					m_slabs.push_back(ft::pair<Node*, size_type>(m_compactSlab, m_compactSize));
+					m_compactNext = Node::searchMinNode(m_root, m_lastElem);
+				}
+				for (; n > 0 && !isSentinel(m_compactNext) && m_compactUsed < m_compactSize; --n)
+				{
+					Node* moved = relocateNode(m_compactNext, m_compactSlab + m_compactUsed);
+					++m_compactUsed;
+					m_compactNext = Node::increment(moved, m_lastElem);
+				}
+				if (!isSentinel(m_compactNext) && m_compactUsed < m_compactSize)
+					return false;
+				endCompaction();
+				releaseFreeNodes();
+				return true;
+			}
+
 // __ Observers
 
 			// Return key comparison object.
@@ -365,12 +936,25 @@ namespace ft
 			// Return value comparison object.
 			value_compare value_comp() const { return value_compare(m_comp); }
 
+// __ Finger Search
+
+			// When enabled, find, insert, operator[] and lower_bound start from the last
+			// accessed node and climb only as far as the key requires before descending,
+			// so a key at distance d from the previous one costs O(log d).
+			void finger_search(bool enable)
+			{
+				m_fingerSearch = enable;
+				m_finger = 0;
+			}
+
+			bool finger_search() const { return m_fingerSearch; }
+
 // __ Operations
 
 			// Searches the container for an element.
 			iterator find(const Key& k)
 			{
-				Node* tmp = searchNode(m_root, k);
+				Node* tmp = noteAccess(searchNode(descentStart(k), k));
 				if (tmp)
 					return iterator(tmp, m_lastElem);
 				return end();
@@ -379,7 +963,7 @@ namespace ft
 			// Searches the container for an element (const).
 			const_iterator find(const Key& k) const
 			{
-				Node* tmp = searchNode(m_root, k);
+				Node* tmp = noteAccess(searchNode(descentStart(k), k));
 				if (tmp)
 					return iterator(tmp, m_lastElem);
 				return end();
@@ -388,48 +972,32 @@ namespace ft
 			// Count elements with a specific key.
 			size_type count (const Key& k) const
 			{
-				Node* tmp = searchNode(m_root, k);
+				Node* tmp = noteAccess(searchNode(descentStart(k), k));
 				return tmp ? true : false;
 			}
 
 			// Return the element whose key is not considered to go before k.
 			iterator lower_bound(const Key& k)
 			{
-				iterator it = begin();
-				for (; it != end(); ++it)
-					if (!m_comp(it->first, k))
-						break;
-				return it;
+				return iterator(lowerBoundNode(k), m_lastElem);
 			}
 
 			// Return the element whose key is not considered to go before k (const).
 			const_iterator lower_bound(const Key& k) const
 			{
-				const_iterator it = begin();
-				for (; it != end(); ++it)
-					if (!m_comp(it->first, k))
-						break;
-				return it;
+				return const_iterator(lowerBoundNode(k), m_lastElem);
 			}
 
 			// Return for the element whose key is considered to go after k.
 			iterator upper_bound(const Key& k)
 			{
-				iterator it = begin();
-				for (; it != end(); ++it)
-					if (m_comp(k, it->first))
-						break;
-				return it;
+				return iterator(upperBoundNode(k), m_lastElem);
 			}
 
 			// Return for the element whose key is considered to go after k (const).
 			const_iterator upper_bound(const Key& k) const
 			{
-				const_iterator it = begin();
-				for (; it != end(); ++it)
-					if (m_comp(k, it->first))
-						break;
-				return it;
+				return const_iterator(upperBoundNode(k), m_lastElem);
 			}
 
 			// Returns the bounds of a range.
@@ -444,8 +1012,89 @@ namespace ft
 				return ft::make_pair(lower_bound(k), upper_bound(k));
 			}
 
+// __ Visitation
+
+			// Calls fn on every element in key order, straight from the tree without going
+			// through iterators. fn returns false to stop early; returns false if it did.
+			template <typename Function>
+			bool for_each(Function fn)
+			{
+				return visitAll<value_type&>(m_root, fn);
+			}
+
+			template <typename Function>
+			bool for_each(Function fn) const
+			{
+				return visitAll<const value_type&>(m_root, fn);
+			}
+
+			// Same as for_each, restricted to keys in [lo, hi). Only the subtrees that
+			// overlap the range are entered.
+			template <typename Function>
+			bool for_each_in_range(const Key& lo, const Key& hi, Function fn)
+			{
+				return visitRange<value_type&>(m_root, lo, hi, fn);
+			}
+
+			template <typename Function>
+			bool for_each_in_range(const Key& lo, const Key& hi, Function fn) const
+			{
+				return visitRange<const value_type&>(m_root, lo, hi, fn);
+			}
+
+// __ Aggregation
+
+			// Combined summary of the keys in [lo, hi), identity if there are none. Descends
+			// to the node where the bounds part ways, then down each bound: every node
+			// in range on the way adds itself plus its whole inner subtree. O(log n).
+			summary_type aggregate(const Key& lo, const Key& hi) const
+			{
+				Node* split = m_root;
+				while (!isSentinel(split))
+				{
+					if (!keyLess(split->content.first, hi))
+						split = split->left;
+					else if (keyLess(split->content.first, lo))
+						split = split->right;
+					else
+						break ;
+				}
+				if (isSentinel(split))
+					return Augment::identity();
+				summary_type before = Augment::identity();
+				for (Node* node = split->left; !isSentinel(node); )
+				{
+					if (keyLess(node->content.first, lo))
+						node = node->right;
+					else
+					{
+						before = Augment::combine(Augment::combine(Augment::lift(node->content.second),
+							summaryOf(node->right)), before);
+						node = node->left;
+					}
+				}
+				summary_type after = Augment::identity();
+				for (Node* node = split->right; !isSentinel(node); )
+				{
+					if (!keyLess(node->content.first, hi))
+						node = node->left;
+					else
+					{
+						after = Augment::combine(after, Augment::combine(summaryOf(node->left),
+							Augment::lift(node->content.second)));
+						node = node->right;
+					}
+				}
+				return Augment::combine(Augment::combine(before, Augment::lift(split->content.second)), after);
+			}
+
 		private:
 
+			summary_type summaryOf(Node* node) const
+			{
+				return isSentinel(node) ? Augment::identity() : node->summary;
+			}
+
 			// Swap.
 			template <typename U>
 			void swap(U& a, U& b)
@@ -455,10 +1104,226 @@ namespace ft
 				b = tmp;
 			}
 
-// __ AVL Binary Search Tree
+// __ In-order Traversal
+
+			template <typename Ref, typename Function>
+			bool visitAll(Node* node, Function& fn) const
+			{
+				if (isSentinel(node))
+					return true;
+				return visitAll<Ref>(node->left, fn)
+					&& fn(static_cast<Ref>(node->content))
+					&& visitAll<Ref>(node->right, fn);
+			}
+
+			// The left subtree can only hold keys in range if this key is not below lo,
+			// the right one only if this key is below hi.
+			template <typename Ref, typename Function>
+			bool visitRange(Node* node, const Key& lo, const Key& hi, Function& fn) const
+			{
+				if (isSentinel(node))
+					return true;
+				bool aboveLo = !keyLess(node->content.first, lo);
+				bool belowHi = keyLess(node->content.first, hi);
+				if (aboveLo && !visitRange<Ref>(node->left, lo, hi, fn))
+					return false;
+				if (aboveLo && belowHi && !fn(static_cast<Ref>(node->content)))
+					return false;
+				if (belowHi)
+					return visitRange<Ref>(node->right, lo, hi, fn);
+				return true;
+			}
+
+// __ Bulk Load
+
+			// Orders input positions by the key they point to.
+			template <typename It>
+			struct bulkLess
+			{
+				Compare comp;
+				bulkLess(const Compare& c) : comp(c) {}
+				bool operator()(const It& a, const It& b) const { return ft::key_order<Compare, Key>::less(comp, (*a).first, (*b).first); }
+			};
+
+			template <typename It>
+			static void sortRun(It* first, It* last, Compare comp)
+			{
+				std::stable_sort(first, last, bulkLess<It>(comp));
+			}
+
+			template <typename It>
+			static void mergeRuns(It* first, It* middle, It* last, It* out, Compare comp)
+			{
+				std::merge(first, middle, middle, last, out, bulkLess<It>(comp));
+			}
+
+			// Threads of a bulk load, held by value. Each task runs under a catch that keeps
+			// its exception for join(), which waits for every thread and rethrows the first
+			// one on the caller's thread. Threads still running when the group is destroyed,
+			// say while an exception unwinds, are joined rather than left to std::terminate.
+			class thread_group
+			{
+				public:
+					explicit thread_group(size_type capacity)
+					{
+						m_threads.reserve(capacity);
+						m_errors.reserve(capacity);
+					}
+
+					~thread_group()
+					{
+						for (size_type i = 0; i < m_threads.size(); ++i)
+							if (m_threads[i].joinable())
+								m_threads[i].join();
+					}
+
+					// At most `capacity` tasks between two joins, their error slots never move.
+					template <typename F, typename... Args>
+					void spawn(F f, Args... args)
+					{
+						m_errors.push_back(std::exception_ptr());
+						try
+						{
+							m_threads.emplace_back(&thread_group::run<F, Args...>, &m_errors.back(), f, args...);
+						}
+						catch (...)
+						{
+							m_errors.pop_back();
+							throw ;
+						}
+					}
+
+					void join()
+					{
+						for (size_type i = 0; i < m_threads.size(); ++i)
+							m_threads[i].join();
+						std::exception_ptr error;
+						for (size_type i = 0; i < m_errors.size() && !error; ++i)
+							error = m_errors[i];
+						m_threads.clear();
+						m_errors.clear();
+						if (error)
+							std::rethrow_exception(error);
+					}
+
+				private:
+					thread_group(const thread_group&);
+					thread_group& operator=(const thread_group&);
+
+					template <typename F, typename... Args>
+					static void run(std::exception_ptr* error, F f, Args... args)
+					{
+						try
+						{
+							f(args...);
+						}
+						catch (...)
+						{
+							*error = std::current_exception();
+						}
+					}
+
+					ft::vector<std::thread>			m_threads;
+					ft::vector<std::exception_ptr>	m_errors;
+			};
+
+			// Sorts one run per thread, then merges neighbouring runs pairwise, each round in
+			// parallel, until one run is left. Both steps are stable so input order survives
+			// among equal keys.
+			template <typename It>
+			void parallelSort(ft::vector<It>& items, unsigned threads)
+			{
+				size_type n = items.size();
+				size_type run = (n + threads - 1) / threads;
+				It* data = items.data();
+				if (run >= n)
+				{
+					sortRun(data, data + n, m_comp);
+					return ;
+				}
+				ft::vector<It> buffer(n, items[0]);
+				It* out = buffer.data();
+				thread_group workers(threads);
+				for (size_type lo = 0; lo < n; lo += run)
+				{
+					size_type hi = lo + run < n ? lo + run : n;
+					workers.spawn(&map::sortRun<It>, data + lo, data + hi, m_comp);
+				}
+				workers.join();
+				for (; run < n; run *= 2)
+				{
+					for (size_type lo = 0; lo < n; lo += 2 * run)
+					{
+						size_type mid = lo + run < n ? lo + run : n;
+						size_type hi = lo + 2 * run < n ? lo + 2 * run : n;
+						workers.spawn(&map::mergeRuns<It>, data + lo, data + mid, data + hi, out + lo, m_comp);
+					}
+					workers.join();
+					swap(data, out);
+				}
+				if (data != items.data())
+					items.swap(buffer);
+			}
+
+			// Keeps one element per run of equal keys and packs them at the front.
+			template <typename It>
+			size_type dropDuplicates(ft::vector<It>& items, duplicate_policy policy)
+			{
+				size_type count = 1;
+				for (size_type i = 1; i < items.size(); ++i)
+				{
+					if (keyLess((*items[count - 1]).first, (*items[i]).first))
+						items[count++] = items[i];
+					else if (policy == keep_last)
+						items[count - 1] = items[i];
+				}
+				return count;
+			}
+
+			// Builds [lo, hi) as a perfectly balanced subtree around its middle element, `depth`
+			// levels below the root of a tree whose deepest level is `maxDepth`. While
+			// `spawnDepth` is not exhausted the left half is built on another thread. Nodes
+			// were acquired beforehand, one slot per element, so threads never share the pool,
+			// and `built` marks the slots holding an element for the caller to undo a failure.
+			template <typename It>
+			Node* buildSubtree(const It* items, Node** slots, char* built, size_type lo, size_type hi,
+			Node* parent, size_type depth, size_type maxDepth, size_type spawnDepth)
+			{
+				if (lo == hi)
+					return m_lastElem;
+				size_type mid = lo + (hi - lo) / 2;
+				Node* node = constructNode(slots[mid], value_type((*items[mid]).first, (*items[mid]).second));
+				built[mid] = 1;
+				node->parent = parent;
+				if (spawnDepth > 0 && mid - lo > 1)
+				{
+					thread_group left(1);
+					left.spawn(&map::buildLeft<It>, this, items, slots, built, lo, mid, node,
+						depth + 1, maxDepth, spawnDepth - 1);
+					node->right = buildSubtree(items, slots, built, mid + 1, hi, node, depth + 1, maxDepth, spawnDepth - 1);
+					left.join();
+				}
+				else
+				{
+					node->left = buildSubtree(items, slots, built, lo, mid, node, depth + 1, maxDepth, spawnDepth);
+					node->right = buildSubtree(items, slots, built, mid + 1, hi, node, depth + 1, maxDepth, spawnDepth);
+				}
+				Balance::initBuiltNode(node, depth, maxDepth, m_lastElem);
+				augment_ops<Augment>::pull(node, m_lastElem);
+				return node;
+			}
+
+			template <typename It>
+			static void buildLeft(map* self, const It* items, Node** slots, char* built, size_type lo, size_type hi,
+			Node* parent, size_type depth, size_type maxDepth, size_type spawnDepth)
+			{
+				parent->left = self->buildSubtree(items, slots, built, lo, hi, parent, depth, maxDepth, spawnDepth);
+			}
+
+// __ Binary Search Tree
 
 			// To check
-			bool isSentinel(Node* node)
+			bool isSentinel(Node* node) const
 			{
 				return node == 0 || node == m_lastElem;
 			}
@@ -466,49 +1331,321 @@ namespace ft
 			// Creates a new node and assign pair.
 			Node* createNode(const value_type& pair)
 			{
-				Node* newNode = m_allocNode.allocate(1);
+				return constructNode(acquireNode(), pair);
+			}
+
+			// Fills raw node storage.
+			Node* constructNode(Node* newNode, const value_type& pair)
+			{
 				m_allocPair.construct(&newNode->content, pair);
+				new (&newNode->summary) summary_type();
+				newNode->setPrefix(prefix_type::make(pair.first));
 				newNode->parent = m_lastElem;
 				newNode->left = m_lastElem;
 				newNode->right = m_lastElem;
+				Balance::initNode(newNode);
 				return newNode;
 			}
 
-			// Calls the destructor.
+			// Calls the destructor, then keeps the node for reuse if the map pools its
+			// nodes or frees it.
 			void deallocateNode(Node* del)
+			{
+				destroyNode(del);
+				releaseNode(del);
+			}
+
+			// Gives back a node holding no element, to the pool or the allocator.
+			void releaseNode(Node* node)
+			{
+				if (m_fixedCapacity || !m_slabs.empty())
+					pushFreeNode(node);
+				else
+					m_allocNode.deallocate(node, 1);
+			}
+
+			void destroyNode(Node* del)
 			{
 				m_allocPair.destroy(&del->content);
-				m_allocNode.deallocate(del, 1);
+				del->summary.~summary_type();
+			}
+
+// __ Node Pool
+
+			// Takes a spare node if there is one, else allocates, unless capacity is fixed.
+			Node* acquireNode()
+			{
+				if (m_freeNodes)
+				{
+					Node* node = m_freeNodes;
+					m_freeNodes = node->right;
+					--m_freeCount;
+					return node;
+				}
+				if (m_fixedCapacity)
+					throw std::length_error("map::insert: fixed capacity exhausted");
+				return m_allocNode.allocate(1);
+			}
+
+			// Spare nodes are chained through their right pointer.
+			void pushFreeNode(Node* node)
+			{
+				node->right = m_freeNodes;
+				m_freeNodes = node;
+				++m_freeCount;
+			}
+
+			// Frees the spare nodes allocated one by one and the blocks whose nodes are all
+			// spare. Blocks are sorted by address so each spare node finds its own with a
+			// binary search.
+			void releaseFreeNodes()
+			{
+				std::sort(m_slabs.data(), m_slabs.data() + m_slabs.size(), slabLess());
+				ft::vector<size_type> spare(m_slabs.size(), 0);
+				for (Node* node = m_freeNodes; node; node = node->right)
+				{
+					size_type slab = slabOf(node);
+					if (slab < m_slabs.size())
+						++spare[slab];
+				}
+				Node* keep = 0;
+				size_type kept = 0;
+				Node* node = m_freeNodes;
+				while (node)
+				{
+					Node* next = node->right;
+					size_type slab = slabOf(node);
+					if (slab == m_slabs.size())
+						m_allocNode.deallocate(node, 1);
+					else if (spare[slab] != m_slabs[slab].second)
+					{
+						node->right = keep;
+						keep = node;
+						++kept;
+					}
+					node = next;
+				}
+				m_freeNodes = keep;
+				m_freeCount = kept;
+				size_type used = 0;
+				for (size_type i = 0; i < m_slabs.size(); ++i)
+				{
+					if (spare[i] == m_slabs[i].second)
+						m_allocNode.deallocate(m_slabs[i].first, m_slabs[i].second);
+					else
+						m_slabs[used++] = m_slabs[i];
+				}
+				while (m_slabs.size() > used)
+					m_slabs.pop_back();
+			}
+
+			// Moves x's element, balance info and links into the raw node y, points x's
+			// neighbours at y and keeps x as a spare. The copies come first, so a throw
+			// leaves x in the tree and y raw.
+			Node* relocateNode(Node* x, Node* y)
+			{
+				m_allocPair.construct(&y->content, x->content);
+				try
+				{
+					new (&y->summary) summary_type(x->summary);
+				}
+				catch (...)
+				{
+					m_allocPair.destroy(&y->content);
+					throw ;
+				}
+				y->setPrefix(x->getPrefix());
+				y->balanceInfo = x->balanceInfo;
+				y->parent = x->parent;
+				y->left = x->left;
+				y->right = x->right;
+				if (isSentinel(x->parent))
+					m_root = y;
+				else if (x->parent->left == x)
+					x->parent->left = y;
+				else
+					x->parent->right = y;
+				if (!isSentinel(y->left))
+					y->left->parent = y;
+				if (!isSentinel(y->right))
+					y->right->parent = y;
+				m_lastElem->parent = m_root;
+				if (m_finger == x)
+					m_finger = y;
+				destroyNode(x);
+				pushFreeNode(x);
+				return y;
+			}
+
+			// Hands the unfilled end of the compaction block over as spare nodes.
+			void endCompaction()
+			{
+				if (!m_compactSlab)
+					return ;
+				for (size_type i = m_compactSize; i > m_compactUsed; --i)
+					pushFreeNode(m_compactSlab + i - 1);
+				m_compactSlab = 0;
+				m_compactNext = 0;
+			}
+
+			struct slabLess
+			{
+				bool operator()(const ft::pair<Node*, size_type>& a, const ft::pair<Node*, size_type>& b) const
+				{ return std::less<Node*>()(a.first, b.first); }
+			};
+
+			// Index of the block holding node, or the number of blocks if none does.
+			size_type slabOf(Node* node) const
+			{
+				size_type lo = 0;
+				size_type hi = m_slabs.size();
+				while (lo < hi)
+				{
+					size_type mid = lo + (hi - lo) / 2;
+					if (std::less<Node*>()(node, m_slabs[mid].first))
+						hi = mid;
+					else
+						lo = mid + 1;
+				}
+				if (lo == 0 || !std::less<Node*>()(node, m_slabs[lo - 1].first + m_slabs[lo - 1].second))
+					return m_slabs.size();
+				return lo - 1;
+			}
+
+			// Strict ordering of two keys, whatever kind of comparator the map holds.
+			bool keyLess(const Key& a, const Key& b) const
+			{
+				return ft::key_order<Compare, Key>::less(m_comp, a, b);
+			}
+
+			// Three-way comparison of k, whose prefix is given, with a node's key. The
+			// cached prefixes settle it unless they tie, only then is the key read.
+			int compareToNode(const Key& k, const prefix& probe, Node* node) const
+			{
+				int order = ft::prefix_order<Compare, Key>::compare(probe, node->getPrefix());
+				if (order != 0)
+					return order;
+				return ft::key_order<Compare, Key>::compare(m_comp, k, node->content.first);
+			}
+
+			// k < node's key, prefixes first.
+			bool lessThanNode(const Key& k, const prefix& probe, Node* node) const
+			{
+				int order = ft::prefix_order<Compare, Key>::compare(probe, node->getPrefix());
+				if (order != 0)
+					return order < 0;
+				return keyLess(k, node->content.first);
 			}
 
-			// Calculates the tree's height.
-			int heightTree(Node *root, int height)
+			// node's key < k, prefixes first.
+			bool nodeLessThan(const Key& k, const prefix& probe, Node* node) const
 			{
-				if (!root || root == m_lastElem)
-					return height - 1;
-				int leftHeight = heightTree(root->left, height + 1);
-				int rightHeight = heightTree(root->right, height + 1);
-				return leftHeight > rightHeight ? leftHeight : rightHeight;
+				int order = ft::prefix_order<Compare, Key>::compare(probe, node->getPrefix());
+				if (order != 0)
+					return order > 0;
+				return keyLess(node->content.first, k);
 			}
 
-			// Searches key in the tree and returns the element if it finds key.
-			Node* searchNode(Node* root, Key k) const
+			// Remembers the node a lookup landed on as the next finger.
+			Node* noteAccess(Node* node) const
 			{
-				if (!root || root == m_lastElem)
-					return 0;
-				if (!m_comp(root->content.first, k) && !m_comp(k, root->content.first))
-					return root;
-				if (root->content.first > k && root->left && root->left != m_lastElem)
-					return searchNode(root->left, k);
-				else if (root->content.first < k && root->right && root->right != m_lastElem)
-					return searchNode(root->right, k);
+				if (m_fingerSearch && !isSentinel(node))
+					m_finger = node;
+				return node;
+			}
+
+			// Where a search for k should begin: the root, or with finger search the lowest
+			// ancestor of the finger whose subtree must hold k. Climbing towards k, only the
+			// ancestors on the side we are heading to bound that subtree, so only they are
+			// compared. When `above` is given it receives the nearest such ancestor with a
+			// key above k, which is the lower bound if the subtree holds nothing >= k.
+			Node* descentStart(const Key& k, Node** above = 0) const
+			{
+				if (!m_fingerSearch || isSentinel(m_finger))
+					return m_root;
+				Node* x = m_finger;
+				prefix probe = prefix_type::make(k);
+				int order = compareToNode(k, probe, x);
+				if (order == 0)
+					return x;
+				bool right = order > 0;
+				while (!isSentinel(x->parent))
+				{
+					Node* p = x->parent;
+					if (right == (p->left == x))
+					{
+						order = compareToNode(k, probe, p);
+						if (order == 0)
+							return p;
+						if ((order < 0) == right)
+						{
+							if (above && right)
+								*above = p;
+							return x;
+						}
+					}
+					x = p;
+				}
+				return x;
+			}
+
+			// Searches key in the tree and returns the element if it finds key. Each level
+			// costs a single three-way comparison when the comparator offers one.
+			Node* searchNode(Node* root, const Key& k) const
+			{
+				prefix probe = prefix_type::make(k);
+				while (!isSentinel(root))
+				{
+					int order = compareToNode(k, probe, root);
+					if (order == 0)
+						return root;
+					root = order < 0 ? root->left : root->right;
+				}
 				return 0;
 			}
 
+			// Descends once, remembering the last node whose key is not below k.
+			Node* lowerBoundNode(const Key& k) const
+			{
+				Node* result = m_lastElem;
+				Node* node = descentStart(k, &result);
+				prefix probe = prefix_type::make(k);
+				while (!isSentinel(node))
+				{
+					if (!nodeLessThan(k, probe, node))
+					{
+						result = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return noteAccess(result);
+			}
+
+			// Descends once, remembering the last node whose key is above k.
+			Node* upperBoundNode(const Key& k) const
+			{
+				Node* result = m_lastElem;
+				Node* node = m_root;
+				prefix probe = prefix_type::make(k);
+				while (!isSentinel(node))
+				{
+					if (lessThanNode(k, probe, node))
+					{
+						result = node;
+						node = node->left;
+					}
+					else
+						node = node->right;
+				}
+				return result;
+			}
+
 			
 			// Inserts a pair in the tree or a specific subtree by adding a new element, and 
-            // then equilibrates the AVL tree if necessary. If element is already present, 
-            // does nothing and return NULL.
+            // then lets the balancing policy equilibrate the tree. The caller has checked
+            // that the key is not present yet.
 			Node* insertNode(Node*& root, const value_type& pair)
 			{
 				if (m_root == m_lastElem)
@@ -517,29 +1654,32 @@ namespace ft
 					m_root->left = m_lastElem;
 					m_root->right = m_lastElem;
 					m_root->parent = m_lastElem;
+					augment_ops<Augment>::pull(m_root, m_lastElem);
+					Balance::afterInsert(m_root, m_root, m_lastElem);
 					m_lastElem->parent = m_root;
 					++m_size;
 					return m_root;
 				}
 				Node* y = m_lastElem;
 				Node* x = root;
+				prefix probe = prefix_type::make(pair.first);
+				bool left = false;
 				while (!isSentinel(x))
 				{
 					y = x;
-					if (m_comp(pair.first, x->content.first))
-						x = x->left;
-					else
-						x = x->right;
+					left = lessThanNode(pair.first, probe, x);
+					x = left ? x->left : x->right;
 				}
 				Node* z = createNode(pair);
 				z->parent = y;
 				if (isSentinel(y))
 					root = z;
-				else if (m_comp(pair.first, y->content.first))
+				else if (left)
 					y->left = z;
 				else
 					y->right = z;
-				balanceTheTree(z);
+				augment_ops<Augment>::pullPath(z, m_lastElem);
+				Balance::afterInsert(z, m_root, m_lastElem);
 				++m_size;
 				m_lastElem->parent = m_root;
 				return z;
@@ -558,165 +1698,99 @@ namespace ft
 					node_2->parent = node_1->parent;
 			}
 
-			// Delete node
-			Node* treeDelete(Node* del)
+			// Unlinks del from the tree. If it has two children its successor takes its place,
+			// color or height included. Reports the child that moved into the emptied position
+			// (maybe the sentinel), that child's parent, and the balance info of the node that
+			// actually left its position, which is what the balancing policy needs.
+			void treeDelete(Node* del, Node*& child, Node*& parent, int& removedInfo)
 			{
-				Node* node = m_lastElem;
-				if (isSentinel(del->left))
+				removedInfo = del->balanceInfo;
+				if (isSentinel(del->left) || isSentinel(del->right))
 				{
-					node = del->right;
-					transplant(del, del->right);
+					child = isSentinel(del->left) ? del->right : del->left;
+					parent = del->parent;
+					transplant(del, child);
+					return ;
 				}
-				else if (isSentinel(del->right))
+				Node* minNode = Node::searchMinNode(del->right, m_lastElem);
+				removedInfo = minNode->balanceInfo;
+				child = minNode->right;
+				if (minNode->parent != del)
 				{
-					node = del->left;
-					transplant(del, del->left);
+					parent = minNode->parent;
+					transplant(minNode, minNode->right);
+					minNode->right = del->right;
+					minNode->right->parent = minNode;
 				}
 				else
-				{
-					Node* minNode = Node::searchMinNode(del->right, m_lastElem);
-					node = minNode->right;
-					if (minNode->parent != del)
-					{
-						transplant(minNode, minNode->right);
-						minNode->right = del->right;
-						minNode->right->parent = minNode;
-
-					}
-					transplant(del, minNode);
-					minNode->left = del->left;
-					minNode->left->parent = minNode;
-				}
-				return node;
+					parent = minNode;
+				transplant(del, minNode);
+				minNode->left = del->left;
+				minNode->left->parent = minNode;
+				minNode->balanceInfo = del->balanceInfo;
 			}
 
-
-			// Deletes the node that matches key from the tree or a specific subtree, and then equilibrates the 
-            // AVL tree if necessary. If element is missing, this function does nothing.
-			bool deleteNode(Key k)
+			// Deletes the node that matches key from the tree, lets the balancing policy
+			// equilibrate the tree and frees the node. If element is missing, this function does nothing.
+			bool deleteNode(const Key& k)
 			{
-				Node* balanceNode = 0;
 				Node* del = searchNode(m_root, k);
 				if (!del || del == m_lastElem)
 					return false;
-				balanceNode = treeDelete(del);
+				if (del == m_finger)
+					m_finger = 0;
+				if (del == m_compactNext)
+					m_compactNext = Node::increment(del, m_lastElem);
+				Node* child;
+				Node* parent;
+				int removedInfo;
+				treeDelete(del, child, parent, removedInfo);
+				augment_ops<Augment>::pullPath(parent, m_lastElem);
+				Balance::afterErase(child, parent, removedInfo, m_root, m_lastElem);
+				m_lastElem->parent = m_root;
+				deallocateNode(del);
 				--m_size;
-				balanceTheTree(balanceNode);
 				return true;
 			}
-
-			// Compares the heights of left and right subtrees.
-			int balanceOfSubtrees(Node* node)
-			{
-				if (!node || node == m_lastElem)
-					return 0;
-				return heightTree(node->left, 1) - heightTree(node->right, 1);
-			}
-
-			// RIGHT ROTATION
-			// Does a right rotation between a node and his left child. The left child will go up and take 
-			// the position of this node, and this node will become the right child of the node going up.
-			void rotateRight(Node* x)
-			{
-				Node* y = x->left;
-				x->left = y->right;
-				if (!isSentinel(y->right))
-					y->right->parent = x;
-				y->parent = x->parent;
-				if (isSentinel(x->parent))
-					m_root = y;
-				else if (x == x->parent->right)
-					x->parent->right = y;
-				else
-					x->parent->left = y;
-				y->right = x;
-				x->parent = y;
-			}
-
-			// LEFT ROTATION
-			// Does a left rotation between a node and his right child. The right child will go up and take
-			// the position of this node; and this node will become the left child of the node going up.
-			void rotateLeft( Node* x)
-			{
-				Node* y = x->right;
-				x->right = y->left;
-				if (!isSentinel(y->left))
-					y->left->parent = x;
-				y->parent = x->parent;
-				if (isSentinel(x->parent))
-					m_root = y;
-				else if (x == x->parent->left)
-					x->parent->left = y;
-				else
-					x->parent->right = y;
-				y->left = x;
-				x->parent = y;
-			}
-
-			// Starts from a node in the AVL tree, and will check for this node and all the parent's node
-            // until root if their balance (height of left and right subtree) is correct. If not, a rotation
-            // (left or right) around the unbalanced node will occured in order to restore tree's balance.
-			void balanceTheTree(Node* node)
-			{
-				while (!isSentinel(node))
-				{
-					int balance = balanceOfSubtrees(node);
-					if (balance < -1 && balanceOfSubtrees(node->right) < 0)
-						rotateLeft(node);
-					else if (balance < -1 && balanceOfSubtrees(node->right) >= 0)
-					{
-						rotateRight(node->right);
-						rotateLeft(node);
-					}
-					else if (balance > 1 && balanceOfSubtrees(node->left) > 0)
-						rotateRight(node);
-					else if (balance > 1 && balanceOfSubtrees(node->left) <= 0)
-					{
-						rotateLeft(node->left);
-						rotateRight(node);
-					}
-					node = node->parent;
-				}
-			}
 	};
 
 	// Non member functions
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	void swap(ft::map<Key, T, Compare, Alloc> &lhs,
-	ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	void swap(ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ lhs.swap(rhs); }
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator==(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator==(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{
 		if (lhs.size() != rhs.size())
 			return (false);
 		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
 	}
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator!=(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator!=(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ return (!(lhs == rhs)); }
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator<(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator<(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end())); }
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator<=(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator<=(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ return (!(rhs < lhs)); }
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator>(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator>(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ return (rhs < lhs); }
 
-	template <typename Key, typename T, typename Compare, typename Alloc>
-	bool operator>=(const ft::map<Key, T, Compare, Alloc> &lhs,
-	const ft::map<Key, T, Compare, Alloc> &rhs)
+	template <typename Key, typename T, typename Compare, typename Alloc, typename Balance, typename Augment>
+	bool operator>=(const ft::map<Key, T, Compare, Alloc, Balance, Augment> &lhs,
+	const ft::map<Key, T, Compare, Alloc, Balance, Augment> &rhs)
 	{ return (!(lhs < rhs)); }
 }
@@ -17,11 +17,19 @@
 #include <functional>
 #include <exception>
 #include <iostream>
+#include <string>
+#include <stdint.h>
 #include "vector_iterator.hpp"
 
 namespace ft
 {
-	template<typename T>
+	// Default augmentation of map nodes: no summary, nothing to maintain.
+	struct no_augment
+	{
+		struct value_type {};
+	};
+
+	template<typename T, typename Augment = ft::no_augment>
 	struct Node;
 
 	// Pair.
@@ -29,6 +37,9 @@ namespace ft
 	class pair
 	{
 		public:
+			typedef T1	first_type;
+			typedef T2	second_type;
+
 			pair() : first(), second() {};
 			pair(const T1& a, const T2& b) : first(a), second(b) {};
 			pair(const pair<T1, T2>& copy) : first(copy.first), second(copy.second) {};
@@ -97,17 +108,20 @@ namespace ft
 	
 	// T			Type of mapped elements.
 	// B 			Boolean to indicate if it's an iterator / a const iterator.
-	template < typename T, bool B>
+	// Augment		Augmentation of the nodes, see ft::map. The summaries depend on the
+	//				mapped values, so an augmented map's iterators are read-only.
+	template < typename T, bool B, typename Augment = ft::no_augment>
 	class map_iterator
 	{
+			static const bool	readOnly = B || !ft::is_same<Augment, ft::no_augment>::value;
 		public:
-			typedef ft::Node<T>															Node;
+			typedef ft::Node<T, Augment>												Node;
 			typedef T																	value_type;
 			typedef long int															difference_type;
 			typedef size_t																size_type;
 			typedef std::bidirectional_iterator_tag										iterator_category;
-			typedef typename chooseConst<B, value_type&, const value_type&>::type		reference;
-			typedef typename chooseConst<B, value_type*, const value_type*>::type		pointer;
+			typedef typename chooseConst<readOnly, value_type&, const value_type&>::type	reference;
+			typedef typename chooseConst<readOnly, value_type*, const value_type*>::type	pointer;
 			typedef Node*																nodePtr;
 		private:
 			nodePtr			m_node;
@@ -121,7 +135,7 @@ namespace ft
 				m_node(node), m_lastElem(lastElem) {}
 
 			// Copy.
-			map_iterator(const map_iterator< T, false>& copy)
+			map_iterator(const map_iterator< T, false, Augment>& copy)
 			{
 				m_node = copy.getNode();
 				m_lastElem = copy.getLastElem();
@@ -301,6 +315,148 @@ namespace ft
 		{ return (a < b); }
 	};
 
+	// Key order.
+	// Three-way comparison of two keys through a map's comparator: negative, zero or
+	// positive like strcmp. A comparator opts in with a compare(a, b) member answering
+	// that way, which is called once. Any other comparator is the usual Compare
+	// predicate, even one whose operator() returns int, and needs a second call when
+	// the first one says "not less". less() gives the usual strict ordering whatever
+	// the kind of comparator.
+	template <typename Compare, typename Key>
+	struct key_order
+	{
+		private:
+			typedef char	predicate[1];
+			typedef char	hasCompare[2];
+
+			// Only named in unevaluated operands, never defined.
+			template <typename T> static T& make();
+
+			template <typename C>
+			static hasCompare& memberOf(char (*)[sizeof(make<const C>().compare(make<const Key>(), make<const Key>()))]);
+			template <typename C>
+			static predicate& memberOf(...);
+
+			static const size_t	kind = sizeof(memberOf<Compare>(0));
+
+			template <size_t K>
+			struct tag {};
+
+			static int call(const Compare& comp, const Key& a, const Key& b, tag<sizeof(predicate)>)
+			{ return comp(a, b) ? -1 : (comp(b, a) ? 1 : 0); }
+			static int call(const Compare& comp, const Key& a, const Key& b, tag<sizeof(hasCompare)>)
+			{ return comp.compare(a, b); }
+
+			static bool callLess(const Compare& comp, const Key& a, const Key& b, tag<sizeof(predicate)>)
+			{ return comp(a, b); }
+			static bool callLess(const Compare& comp, const Key& a, const Key& b, tag<sizeof(hasCompare)>)
+			{ return comp.compare(a, b) < 0; }
+
+		public:
+			static const bool	three_way = kind == sizeof(hasCompare);
+
+			static int compare(const Compare& comp, const Key& a, const Key& b)
+			{ return call(comp, a, b, tag<kind>()); }
+
+			static bool less(const Compare& comp, const Key& a, const Key& b)
+			{ return callLess(comp, a, b, tag<kind>()); }
+	};
+
+	// ft::less over strings already has a three-way form in basic_string::compare.
+	template <typename C, typename Traits, typename Alloc>
+	struct key_order<ft::less<std::basic_string<C, Traits, Alloc> >, std::basic_string<C, Traits, Alloc> >
+	{
+		static const bool	three_way = true;
+
+		static int compare(const ft::less<std::basic_string<C, Traits, Alloc> >&,
+		const std::basic_string<C, Traits, Alloc>& a, const std::basic_string<C, Traits, Alloc>& b)
+		{ return a.compare(b); }
+
+		static bool less(const ft::less<std::basic_string<C, Traits, Alloc> >&,
+		const std::basic_string<C, Traits, Alloc>& a, const std::basic_string<C, Traits, Alloc>& b)
+		{ return a < b; }
+	};
+
+	// Key prefix.
+	// Leading bytes of a key packed into an integer that orders like the key itself,
+	// kept in map nodes so a descent can settle most comparisons without following the
+	// key to its heap buffer. It costs 8 bytes per node, so a key type opts in by
+	// specializing ft::cache_key_prefix, before any map of it is used:
+	//   namespace ft { template <> struct cache_key_prefix<std::string> : ft::true_type {}; }
+	// Other keys carry ft::no_prefix, which takes no room, and are compared in full.
+	template <typename Key>
+	struct cache_key_prefix : ft::false_type {};
+
+	struct no_prefix {};
+
+	template <typename Key, bool Cached = ft::cache_key_prefix<Key>::value>
+	struct key_prefix
+	{
+		typedef ft::no_prefix	type;
+
+		static type make(const Key&) { return type(); }
+	};
+
+	template <typename Key, bool Cached>
+	struct key_prefix<const Key, Cached> : key_prefix<Key> {};
+
+	// Up to the first 8 bytes of a string, big-endian and zero-padded. char_traits<char>
+	// compares bytes as unsigned char, so the integers order like the strings except
+	// on a tie, where a shorter key padded with zeros may still differ from a longer one.
+	template <typename Alloc>
+	struct key_prefix<std::basic_string<char, std::char_traits<char>, Alloc>, true>
+	{
+		typedef uint64_t	type;
+
+		static type make(const std::basic_string<char, std::char_traits<char>, Alloc>& key)
+		{
+			type prefix = 0;
+			size_t len = key.size() < 8 ? key.size() : 8;
+			for (size_t i = 0; i < 8; ++i)
+				prefix = (prefix << 8) | (i < len ? static_cast<unsigned char>(key[i]) : 0);
+			return prefix;
+		}
+	};
+
+	// Where a node keeps its key prefix, a base so that ft::no_prefix adds nothing.
+	template <typename Prefix>
+	struct prefix_slot
+	{
+		Prefix	keyPrefix;
+
+		const Prefix& getPrefix() const { return keyPrefix; }
+		void setPrefix(const Prefix& prefix) { keyPrefix = prefix; }
+	};
+
+	template <>
+	struct prefix_slot<ft::no_prefix>
+	{
+		ft::no_prefix getPrefix() const { return ft::no_prefix(); }
+		void setPrefix(const ft::no_prefix&) {}
+	};
+
+	// Prefix order.
+	// Says whether two key prefixes already decide a comparator's answer: negative or
+	// positive when they do, zero when the full keys must be compared. Only the
+	// natural byte order of strings agrees with their prefixes.
+	template <typename Compare, typename Key>
+	struct prefix_order
+	{
+		static int compare(const typename key_prefix<Key>::type&, const typename key_prefix<Key>::type&)
+		{ return 0; }
+	};
+
+	template <typename Key>
+	struct prefix_order<ft::less<Key>, Key>
+	{
+		template <typename P>
+		static int compare(const P&, const P&) { return 0; }
+		static int compare(uint64_t a, uint64_t b) { return a < b ? -1 : (a > b ? 1 : 0); }
+	};
+
+	template <typename Key>
+	struct prefix_order<std::less<Key>, Key> : prefix_order<ft::less<Key>, Key> {};
+
 	// Make pair.
 	template <typename T1, typename T2>
 	ft::pair<T1, T2> make_pair(T1 a, T2 b)
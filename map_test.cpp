@@ -7,7 +7,26 @@
 #include <vector>
 #include <list>
 #include <functional>
+#include <limits>
+#include <thread>
+#if __cplusplus >= 201703L
+# include <memory_resource>
+#endif
 #include "map.hpp"
+#include "frozen_map.hpp"
+#include "learned_map.hpp"
+#include "compact_map.hpp"
+#include "concurrent_skiplist_map.hpp"
+#include "radix_map.hpp"
+#include "small_map.hpp"
+#include "memory_resource.hpp"
+
+// String-keyed maps here cache key prefixes in their nodes, see example 34.
+namespace ft
+{
+	template <>
+	struct cache_key_prefix<std::string> : ft::true_type {};
+}
 
 #ifndef	MYCOLORS_HPP
 # define MYCOLORS_HPP
@@ -1584,6 +1603,807 @@ static void	example22()
 	std::cout << '.' << COLOR_END << std::endl;
 }
 
+static void	example23()
+{
+	/* Example 23 */
+	/* Example for frozen_map: find, lower_bound, upper_bound and iteration */
+
+	std::cout << COLOR_PURPLE_B << "Example 23" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, std::string> mp;
+	for (int i = 0; i < 10; ++i)
+		mp[i * 3] = std::string(i + 1, 'a' + i);
+	std::cout << "std::map        -> size: " << mp.size();
+	std::cout << ", value:";
+	for (std::map<int, std::string>::const_iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", find(9): " << mp.find(9)->second;
+	std::cout << ", count(10): " << mp.count(10);
+	std::cout << ", lower_bound(10): " << mp.lower_bound(10)->first;
+	std::cout << ", upper_bound(12): " << mp.upper_bound(12)->first;
+	std::cout << ", lower_bound(28) == end: " << (mp.lower_bound(28) == mp.end());
+	std::cout << ", back: " << (--mp.end())->first;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, std::string> ft_mp;
+	for (int i = 0; i < 10; ++i)
+		ft_mp[i * 3] = std::string(i + 1, 'a' + i);
+	ft::frozen_map<int, std::string> ft_fz(ft_mp);
+	ft_mp.clear();
+	std::cout << "ft::frozen_map  -> size: " << ft_fz.size();
+	std::cout << ", value:";
+	for (ft::frozen_map<int, std::string>::const_iterator it = ft_fz.begin(); it != ft_fz.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", find(9): " << ft_fz.find(9)->second;
+	std::cout << ", count(10): " << ft_fz.count(10);
+	std::cout << ", lower_bound(10): " << ft_fz.lower_bound(10)->first;
+	std::cout << ", upper_bound(12): " << ft_fz.upper_bound(12)->first;
+	std::cout << ", lower_bound(28) == end: " << (ft_fz.lower_bound(28) == ft_fz.end());
+	std::cout << ", back: " << (--ft_fz.end())->first;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example24()
+{
+	/* Example 24 */
+	/* Example for bulk_load with duplicate keys */
+
+	int keys[] = {42, 7, 19, 7, 3, 88, 19, 64, 1, 42, 55, 7};
+
+	std::cout << COLOR_PURPLE_B << "Example 24" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 12; ++i)
+		mp[keys[i]] = i;
+	std::cout << "std::map -> size: " << mp.size();
+	std::cout << ", value:";
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::vector<ft::pair<int, int> > ft_in;
+	for (int i = 0; i < 12; ++i)
+		ft_in.push_back(ft::make_pair(keys[i], i));
+	ft::map<int, int> ft_mp;
+	ft_mp[1000] = 1000;
+	ft_mp.bulk_load(ft_in.begin(), ft_in.end(), 4, ft::keep_last);
+	std::cout << "ft::map  -> size: " << ft_mp.size();
+	std::cout << ", value:";
+	for (ft::map<int, int>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+struct	PrintUntil
+{
+	int	stop;
+	PrintUntil(int s) : stop(s) {}
+	bool	operator()(const ft::pair<const int, std::string>& p) const
+	{
+		std::cout << " " << p.first << "=" << p.second;
+		return p.first != stop;
+	}
+};
+
+static void	example25()
+{
+	/* Example 25 */
+	/* Example for for_each and for_each_in_range */
+
+	std::cout << COLOR_PURPLE_B << "Example 25" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, std::string> mp;
+	for (int i = 0; i < 10; ++i)
+		mp[i * 5] = std::string(1, 'a' + i);
+	std::cout << "std::map -> all:";
+	for (std::map<int, std::string>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", [12, 31):";
+	for (std::map<int, std::string>::iterator it = mp.lower_bound(12); it != mp.lower_bound(31); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", until 20:";
+	for (std::map<int, std::string>::iterator it = mp.lower_bound(12); it != mp.upper_bound(20); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, std::string> ft_mp;
+	for (int i = 0; i < 10; ++i)
+		ft_mp[i * 5] = std::string(1, 'a' + i);
+	std::cout << "ft::map  -> all:";
+	ft_mp.for_each(PrintUntil(-1));
+	std::cout << ", [12, 31):";
+	ft_mp.for_each_in_range(12, 31, PrintUntil(-1));
+	std::cout << ", until 20:";
+	ft_mp.for_each_in_range(12, 100, PrintUntil(20));
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example26()
+{
+	/* Example 26 */
+	/* Example for compact_map: insert, erase, bounds and iteration */
+
+	std::cout << COLOR_PURPLE_B << "Example 26" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 40; ++i)
+		mp[(i * 17) % 40] = i;
+	for (int i = 0; i < 40; i += 3)
+		mp.erase(i);
+	std::cout << "std::map          -> size: " << mp.size();
+	std::cout << ", value:";
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", lower_bound(9): " << mp.lower_bound(9)->first;
+	std::cout << ", upper_bound(10): " << mp.upper_bound(10)->first;
+	std::cout << ", reverse:";
+	for (std::map<int, int>::iterator it = mp.end(); it != mp.begin();)
+		std::cout << " " << (--it)->first;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::compact_map<int, int> ft_mp;
+	for (int i = 0; i < 40; ++i)
+		ft_mp[(i * 17) % 40] = i;
+	for (int i = 0; i < 40; i += 3)
+		ft_mp.erase(i);
+	std::cout << "ft::compact_map   -> size: " << ft_mp.size();
+	std::cout << ", value:";
+	for (ft::compact_map<int, int>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", lower_bound(9): " << ft_mp.lower_bound(9)->first;
+	std::cout << ", upper_bound(10): " << ft_mp.upper_bound(10)->first;
+	std::cout << ", reverse:";
+	for (ft::compact_map<int, int>::iterator it = ft_mp.end(); it != ft_mp.begin();)
+		std::cout << " " << (--it)->first;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+struct	LengthFirstLess
+{
+	bool	operator()(const std::string& a, const std::string& b) const
+	{ return a.size() != b.size() ? a.size() < b.size() : a < b; }
+};
+
+struct	LengthFirstCompare
+{
+	int		compare(const std::string& a, const std::string& b) const
+	{
+		if (a.size() != b.size())
+			return a.size() < b.size() ? -1 : 1;
+		return a.compare(b);
+	}
+};
+
+static void	example27()
+{
+	/* Example 27 */
+	/* Example for a three-way comparator with a compare() member */
+
+	std::string	words[] = {"pear", "fig", "banana", "kiwi", "apple", "fig", "plum"};
+
+	std::cout << COLOR_PURPLE_B << "Example 27" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<std::string, int, LengthFirstLess> mp;
+	for (int i = 0; i < 7; ++i)
+		mp[words[i]] += i;
+	std::cout << "std::map -> size: " << mp.size();
+	std::cout << ", value:";
+	for (std::map<std::string, int, LengthFirstLess>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", count(kiwi): " << mp.count("kiwi");
+	std::cout << ", lower_bound(lime): " << mp.lower_bound("lime")->first;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<std::string, int, LengthFirstCompare> ft_mp;
+	for (int i = 0; i < 7; ++i)
+		ft_mp[words[i]] += i;
+	std::cout << "ft::map  -> size: " << ft_mp.size();
+	std::cout << ", value:";
+	for (ft::map<std::string, int, LengthFirstCompare>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", count(kiwi): " << ft_mp.count("kiwi");
+	std::cout << ", lower_bound(lime): " << ft_mp.lower_bound("lime")->first;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example28()
+{
+	/* Example 28 */
+	/* Example for finger search with sequential and clustered lookups */
+
+	int	probes[] = {10, 11, 13, 12, 40, 41, 39, 44, 2, 3, 1, 0};
+
+	std::cout << COLOR_PURPLE_B << "Example 28" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 50; i += 2)
+		mp[i] = i * i;
+	std::cout << "std::map -> find:";
+	for (int i = 0; i < 12; ++i)
+		std::cout << " " << (mp.find(probes[i]) != mp.end() ? mp.find(probes[i])->second : -1);
+	std::cout << ", lower_bound:";
+	for (int i = 0; i < 12; ++i)
+		std::cout << " " << mp.lower_bound(probes[i])->first;
+	mp.insert(std::make_pair(13, 0));
+	mp.erase(12);
+	mp[15] = 1;
+	std::cout << ", value:";
+	for (std::map<int, int>::iterator it = mp.lower_bound(8); it != mp.upper_bound(18); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, int> ft_mp;
+	ft_mp.finger_search(true);
+	for (int i = 0; i < 50; i += 2)
+		ft_mp[i] = i * i;
+	std::cout << "ft::map  -> find:";
+	for (int i = 0; i < 12; ++i)
+		std::cout << " " << (ft_mp.find(probes[i]) != ft_mp.end() ? ft_mp.find(probes[i])->second : -1);
+	std::cout << ", lower_bound:";
+	for (int i = 0; i < 12; ++i)
+		std::cout << " " << ft_mp.lower_bound(probes[i])->first;
+	ft_mp.insert(ft::make_pair(13, 0));
+	ft_mp.erase(12);
+	ft_mp[15] = 1;
+	std::cout << ", value:";
+	for (ft::map<int, int>::iterator it = ft_mp.lower_bound(8); it != ft_mp.upper_bound(18); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example29()
+{
+	/* Example 29 */
+	/* Example for the red-black balancing policy under interleaved inserts and erases */
+
+	std::cout << COLOR_PURPLE_B << "Example 29" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 64; ++i)
+		mp[(i * 37) % 64] = i;
+	for (int i = 0; i < 64; i += 3)
+		mp.erase(i);
+	mp.erase(mp.begin());
+	std::cout << "std::map -> size: " << mp.size() << ", front: " << mp.begin()->first
+		<< ", back: " << (--mp.end())->first << ", value:";
+	for (std::map<int, int>::iterator it = mp.lower_bound(20); it != mp.upper_bound(32); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	typedef ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::red_black_balance>	rb_map;
+	rb_map ft_mp;
+	for (int i = 0; i < 64; ++i)
+		ft_mp[(i * 37) % 64] = i;
+	for (int i = 0; i < 64; i += 3)
+		ft_mp.erase(i);
+	ft_mp.erase(ft_mp.begin());
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", front: " << ft_mp.begin()->first
+		<< ", back: " << (--ft_mp.end())->first << ", value:";
+	for (rb_map::iterator it = ft_mp.lower_bound(20); it != ft_mp.upper_bound(32); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+struct	FillAndThin
+{
+	ft::concurrent_skiplist_map<int, int>*	map;
+	int										first;
+	FillAndThin(ft::concurrent_skiplist_map<int, int>* m, int f) : map(m), first(f) {}
+	void	operator()() const
+	{
+		for (int i = first; i < first + 16; ++i)
+			map->insert(ft::make_pair(i, i * 10));
+		for (int i = first; i < first + 16; i += 3)
+			map->erase(i);
+	}
+};
+
+static void	example30()
+{
+	/* Example 30 */
+	/* Example for concurrent_skiplist_map filled and thinned by four threads */
+
+	std::cout << COLOR_PURPLE_B << "Example 30" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int t = 0; t < 4; ++t)
+	{
+		for (int i = t * 16; i < t * 16 + 16; ++i)
+			mp.insert(std::make_pair(i, i * 10));
+		for (int i = t * 16; i < t * 16 + 16; i += 3)
+			mp.erase(i);
+	}
+	std::cout << "std::map -> size: " << mp.size() << ", find 23: " << mp.find(23)->second
+		<< ", count 48: " << mp.count(48) << ", value:";
+	for (std::map<int, int>::iterator it = mp.lower_bound(20); it != mp.upper_bound(40); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::concurrent_skiplist_map<int, int> ft_mp;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.push_back(std::thread(FillAndThin(&ft_mp, t * 16)));
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", find 23: " << ft_mp.find(23)->second
+		<< ", count 48: " << ft_mp.count(48) << ", value:";
+	for (ft::concurrent_skiplist_map<int, int>::iterator it = ft_mp.lower_bound(20); it != ft_mp.upper_bound(40); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example31()
+{
+	/* Example 31 */
+	/* Example for augmented maps: range sums and an interval tree */
+
+	int	points[] = {5, 12, 21, 40};
+
+	std::cout << COLOR_PURPLE_B << "Example 31" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	std::map<int, int> spans;
+	for (int i = 0; i < 30; ++i)
+		mp[i * 3] = i;
+	mp.erase(30);
+	mp[33] = 100;
+	for (int i = 0; i < 6; ++i)
+		spans[i * 7] = i * 7 + (i % 3 + 1) * 3;
+	std::cout << "std::map -> sum [10, 50):";
+	int sum = 0;
+	for (std::map<int, int>::iterator it = mp.lower_bound(10); it != mp.lower_bound(50); ++it)
+		sum += it->second;
+	std::cout << " " << sum << ", covered:";
+	for (int p = 0; p < 4; ++p)
+	{
+		int end = std::numeric_limits<int>::min();
+		for (std::map<int, int>::iterator it = spans.begin(); it != spans.upper_bound(points[p]); ++it)
+			end = std::max(end, it->second);
+		std::cout << " " << points[p] << (end > points[p] ? "=yes" : "=no");
+	}
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::avl_balance, ft::sum_augment<int> >	ft_mp;
+	ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::red_black_balance, ft::max_augment<int> >	ft_spans;
+	for (int i = 0; i < 30; ++i)
+		ft_mp.insert_or_assign(i * 3, i);
+	ft_mp.erase(30);
+	ft_mp.insert_or_assign(33, 100);
+	for (int i = 0; i < 6; ++i)
+		ft_spans.insert(ft::make_pair(i * 7, i * 7 + (i % 3 + 1) * 3));
+	std::cout << "ft::map  -> sum [10, 50): " << ft_mp.aggregate(10, 50) << ", covered:";
+	for (int p = 0; p < 4; ++p)
+		std::cout << " " << points[p] << (ft_spans.aggregate(std::numeric_limits<int>::min(), points[p] + 1)
+			> points[p] ? "=yes" : "=no");
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example32()
+{
+	/* Example 32 */
+	/* Example for radix_map with path keys sharing long prefixes */
+
+	std::string	paths[] = {"/api/v1/users", "/api/v1/users/42", "/api/v1/orders", "/api/v2/users",
+		"/static/css/site.css", "/static/js/app.js", "/", "/api", "/api/v1/users/7"};
+
+	std::cout << COLOR_PURPLE_B << "Example 32" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<std::string, int> mp;
+	for (int i = 0; i < 9; ++i)
+		mp[paths[i]] = i;
+	mp.erase("/api/v1/orders");
+	mp.erase("/api");
+	std::cout << "std::map -> size: " << mp.size() << ", find: " << mp.find("/api/v1/users/42")->second
+		<< ", lower_bound /api/v1/u: " << mp.lower_bound("/api/v1/u")->first << ", all:";
+	for (std::map<std::string, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::radix_map<std::string, int> ft_mp;
+	for (int i = 0; i < 9; ++i)
+		ft_mp[paths[i]] = i;
+	ft_mp.erase("/api/v1/orders");
+	ft_mp.erase("/api");
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", find: " << ft_mp.find("/api/v1/users/42")->second
+		<< ", lower_bound /api/v1/u: " << ft_mp.lower_bound("/api/v1/u")->first << ", all:";
+	for (ft::radix_map<std::string, int>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example33()
+{
+	/* Example 33 */
+	/* Example for small_map: inline up to N elements, then spilled into a tree */
+
+	std::cout << COLOR_PURPLE_B << "Example 33" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, char> mp;
+	for (int i = 0; i < 6; ++i)
+		mp[(i * 5) % 11] = 'a' + i;
+	mp.erase(4);
+	std::cout << "std::map -> small:";
+	for (std::map<int, char>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	for (int i = 20; i < 26; ++i)
+		mp[i] = 'A' + i - 20;
+	std::cout << ", size: " << mp.size() << ", lower_bound 7: " << mp.lower_bound(7)->first
+		<< ", last: " << (--mp.end())->first << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::small_map<int, char, 8> ft_mp;
+	for (int i = 0; i < 6; ++i)
+		ft_mp[(i * 5) % 11] = 'a' + i;
+	ft_mp.erase(4);
+	std::cout << "ft::map  -> small:";
+	for (ft::small_map<int, char, 8>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	for (int i = 20; i < 26; ++i)
+		ft_mp[i] = 'A' + i - 20;
+	std::cout << ", size: " << ft_mp.size() << ", lower_bound 7: " << ft_mp.lower_bound(7)->first
+		<< ", last: " << (--ft_mp.end())->first << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example34()
+{
+	/* Example 34 */
+	/* Example for string keys with cached prefixes: most are told apart by their first 8 bytes, some only later */
+
+	const char* keys[] = { "zebra", "applesauce", "applesauce!", "applesau", "apple", "",
+		"/api/v1/users", "/api/v1/orders", "/api/v1/" };
+	std::string nul("applesau\0", 9);
+
+	std::cout << COLOR_PURPLE_B << "Example 34" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<std::string, int> mp;
+	for (int i = 0; i < 9; ++i)
+		mp[keys[i]] = i;
+	mp[nul] = 9;
+	mp.erase("applesauce");
+	std::cout << "std::map -> size: " << mp.size() << ", find /api/v1/orders: " << mp.find("/api/v1/orders")->second
+		<< ", after applesau: " << mp.upper_bound("applesau")->second << ", lower_bound applesaud: "
+		<< mp.lower_bound("applesaud")->first << ", all:";
+	for (std::map<std::string, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<std::string, int> ft_mp;
+	for (int i = 0; i < 9; ++i)
+		ft_mp[keys[i]] = i;
+	ft_mp[nul] = 9;
+	ft_mp.erase("applesauce");
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", find /api/v1/orders: " << ft_mp.find("/api/v1/orders")->second
+		<< ", after applesau: " << ft_mp.upper_bound("applesau")->second << ", lower_bound applesaud: "
+		<< ft_mp.lower_bound("applesaud")->first << ", all:";
+	for (ft::map<std::string, int>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example35()
+{
+	/* Example 35 */
+	/* Example for reserve and fixed capacity: churn without allocating, then refuse to grow */
+
+	std::cout << COLOR_PURPLE_B << "Example 35" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 40; ++i)
+	{
+		mp[(i * 7) % 23] = i;
+		if (mp.size() > 12)
+			mp.erase(mp.begin());
+	}
+	while (mp.size() < 16)
+		mp[100 + (int)mp.size()] = 0;
+	std::cout << "std::map -> size: " << mp.size() << ", capacity: 16, insert 99: refused, all:";
+	for (std::map<int, int>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, int> ft_mp;
+	ft_mp.reserve(16);
+	ft_mp.fixed_capacity(true);
+	for (int i = 0; i < 40; ++i)
+	{
+		ft_mp[(i * 7) % 23] = i;
+		if (ft_mp.size() > 12)
+			ft_mp.erase(ft_mp.begin());
+	}
+	while (ft_mp.size() < 16)
+		ft_mp[100 + (int)ft_mp.size()] = 0;
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", capacity: " << ft_mp.capacity() << ", insert 99: ";
+	try
+	{
+		ft_mp[99] = 0;
+		std::cout << "accepted";
+	}
+	catch (std::length_error&)
+	{
+		std::cout << "refused";
+	}
+	std::cout << ", all:";
+	for (ft::map<int, int>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example36()
+{
+	/* Example 36 */
+	/* Example for compact: nodes moved into key order in memory, map still usable */
+
+	std::cout << COLOR_PURPLE_B << "Example 36" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, std::string> mp;
+	for (int i = 0; i < 30; ++i)
+		mp[(i * 17) % 31] = std::string(1, 'a' + i % 26);
+	for (int i = 0; i < 30; i += 4)
+		mp.erase(i);
+	mp[40] = "z";
+	std::cout << "std::map -> size: " << mp.size() << ", in memory order: yes, all:";
+	for (std::map<int, std::string>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, std::string> ft_mp;
+	for (int i = 0; i < 30; ++i)
+		ft_mp[(i * 17) % 31] = std::string(1, 'a' + i % 26);
+	ft_mp.compact_step(10);
+	for (int i = 0; i < 30; i += 4)
+		ft_mp.erase(i);
+	ft_mp.compact();
+	ft_mp[40] = "z";
+	bool ordered = true;
+	const ft::pair<const int, std::string>* prev = 0;
+	for (ft::map<int, std::string>::iterator it = ft_mp.begin(); it->first != 40; ++it)
+	{
+		if (prev && &*it < prev)
+			ordered = false;
+		prev = &*it;
+	}
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", in memory order: " << (ordered ? "yes" : "no") << ", all:";
+	for (ft::map<int, std::string>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+static void	example37()
+{
+	/* Example 37 */
+	/* Example for learned_map: lookups through a piecewise-linear model of the keys */
+
+	std::cout << COLOR_PURPLE_B << "Example 37" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<long, int> mp;
+	for (int i = 0; i < 200; ++i)
+		mp[(long)i * i - 300] = i;
+	std::cout << "std::map         -> size: " << mp.size();
+	std::cout << ", find(1300): " << mp.find(1300)->second;
+	std::cout << ", count(1301): " << mp.count(1301);
+	std::cout << ", lower_bound(-1000): " << mp.lower_bound(-1000)->first;
+	std::cout << ", lower_bound(5000): " << mp.lower_bound(5000)->first;
+	std::cout << ", upper_bound(39000): " << mp.upper_bound(39000)->first;
+	std::cout << ", lower_bound(39302) == end: " << (mp.lower_bound(39302) == mp.end());
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<long, int> ft_mp;
+	for (int i = 0; i < 200; ++i)
+		ft_mp[(long)i * i - 300] = i;
+	ft::learned_map<long, int> ft_lm(ft_mp, 4);
+	ft_mp.clear();
+	std::cout << "ft::learned_map  -> size: " << ft_lm.size();
+	std::cout << ", find(1300): " << ft_lm.find(1300)->second;
+	std::cout << ", count(1301): " << ft_lm.count(1301);
+	std::cout << ", lower_bound(-1000): " << ft_lm.lower_bound(-1000)->first;
+	std::cout << ", lower_bound(5000): " << ft_lm.lower_bound(5000)->first;
+	std::cout << ", upper_bound(39000): " << ft_lm.upper_bound(39000)->first;
+	std::cout << ", lower_bound(39302) == end: " << (ft_lm.lower_bound(39302) == ft_lm.end());
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
+// Examples 38 and 40 compare with std::pmr, which needs C++17.
+#if __cplusplus >= 201703L
+static void	example38()
+{
+	/* Example 38 */
+	/* Example for a map and a vector in a monotonic arena over a local buffer, nothing on the heap */
+
+	std::cout << COLOR_PURPLE_B << "Example 38" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	alignas(std::max_align_t) char buffer[16384];
+	{
+		std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+		std::pmr::map<int, int> mp(&arena);
+		std::pmr::vector<int> vct(&arena);
+		for (int i = 0; i < 50; ++i)
+		{
+			mp[(i * 17) % 50] = i;
+			vct.push_back(i * i);
+		}
+		mp.erase(10);
+		std::cout << "std::map -> size: " << mp.size() << ", vector size: " << vct.size();
+		std::cout << ", mp[0]: " << mp[0] << ", mp[49]: " << mp[49] << ", back: " << vct.back();
+		std::cout << ", beyond the buffer: ";
+		try
+		{
+			std::pmr::vector<char> big(sizeof(buffer), 'x', &arena);
+			std::cout << "accepted";
+		}
+		catch (std::bad_alloc&)
+		{
+			std::cout << "refused";
+		}
+		std::cout << '.' << COLOR_END << std::endl;
+	}
+
+	std::cout << COLOR_GREEN_B;
+	{
+		ft::monotonic_buffer_resource arena(buffer, sizeof(buffer), ft::null_memory_resource());
+		ft::polymorphic_allocator<ft::pair<const int, int> > alloc(&arena);
+		ft::map<int, int, ft::less<int>, ft::polymorphic_allocator<ft::pair<const int, int> > > ft_mp(ft::less<int>(), alloc);
+		ft::vector<int, ft::polymorphic_allocator<int> > ft_vct(alloc);
+		for (int i = 0; i < 50; ++i)
+		{
+			ft_mp[(i * 17) % 50] = i;
+			ft_vct.push_back(i * i);
+		}
+		ft_mp.erase(10);
+		std::cout << "ft::map  -> size: " << ft_mp.size() << ", vector size: " << ft_vct.size();
+		std::cout << ", mp[0]: " << ft_mp[0] << ", mp[49]: " << ft_mp[49] << ", back: " << ft_vct.back();
+		std::cout << ", beyond the buffer: ";
+		try
+		{
+			ft::vector<char, ft::polymorphic_allocator<char> > big(sizeof(buffer), 'x', alloc);
+			std::cout << "accepted";
+		}
+		catch (std::bad_alloc&)
+		{
+			std::cout << "refused";
+		}
+		std::cout << '.' << COLOR_END << std::endl << std::endl;
+	}
+}
+#endif
+
+struct	IntReturningLess
+{
+	int		operator()(int a, int b) const { return a < b; }
+};
+
+static void	example39()
+{
+	/* Example 39 */
+	/* Example for a predicate whose operator() returns int, still a plain Compare */
+
+	std::cout << COLOR_PURPLE_B << "Example 39" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int, IntReturningLess> mp;
+	for (int i = 9; i >= 0; --i)
+		mp[(i * 7) % 10] = i;
+	std::cout << "std::map -> size: " << mp.size() << ", value:";
+	for (std::map<int, int, IntReturningLess>::iterator it = mp.begin(); it != mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", count(3): " << mp.count(3) << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, int, IntReturningLess> ft_mp;
+	for (int i = 9; i >= 0; --i)
+		ft_mp[(i * 7) % 10] = i;
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", value:";
+	for (ft::map<int, int, IntReturningLess>::iterator it = ft_mp.begin(); it != ft_mp.end(); ++it)
+		std::cout << " " << it->first << "=" << it->second;
+	std::cout << ", count(3): " << ft_mp.count(3) << '.' << COLOR_END << std::endl << std::endl;
+}
+
+#if __cplusplus >= 201703L
+static void	example40()
+{
+	/* Example 40 */
+	/* Example for copies out of a per-request arena: assignment keeps the target's resource, a copy gets the default one */
+
+	std::cout << COLOR_PURPLE_B << "Example 40" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::pmr::map<int, std::string> cache;
+	std::pmr::vector<std::string> vcache;
+	bool copyDefault;
+	{
+		std::pmr::monotonic_buffer_resource arena;
+		std::pmr::map<int, std::string> request(&arena);
+		std::pmr::vector<std::string> vrequest(&arena);
+		for (int i = 0; i < 20; ++i)
+		{
+			request[i] = std::string(30, 'a' + i);
+			vrequest.push_back(std::string(30, 'a' + i));
+		}
+		cache = request;
+		vcache = vrequest;
+		std::pmr::map<int, std::string> copy(request);
+		copyDefault = copy.get_allocator().resource() == std::pmr::get_default_resource();
+	}
+	std::cout << "std::map -> size: " << cache.size() << ", cache[19]: " << cache[19];
+	std::cout << ", vector back: " << vcache.back() << ", copy on default: " << copyDefault;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	typedef ft::polymorphic_allocator<ft::pair<const int, std::string> >	pair_allocator;
+	ft::map<int, std::string, ft::less<int>, pair_allocator> ft_cache;
+	ft::vector<std::string, ft::polymorphic_allocator<std::string> > ft_vcache;
+	bool ft_copyDefault;
+	{
+		ft::monotonic_buffer_resource arena;
+		ft::map<int, std::string, ft::less<int>, pair_allocator> request((ft::less<int>()), pair_allocator(&arena));
+		ft::vector<std::string, ft::polymorphic_allocator<std::string> > vrequest((ft::polymorphic_allocator<std::string>(&arena)));
+		for (int i = 0; i < 20; ++i)
+		{
+			request[i] = std::string(30, 'a' + i);
+			vrequest.push_back(std::string(30, 'a' + i));
+		}
+		ft_cache = request;
+		ft_vcache = vrequest;
+		ft::map<int, std::string, ft::less<int>, pair_allocator> copy(request);
+		ft_copyDefault = copy.get_allocator().resource() == ft::get_default_resource();
+	}
+	std::cout << "ft::map  -> size: " << ft_cache.size() << ", cache[19]: " << ft_cache[19];
+	std::cout << ", vector back: " << ft_vcache.back() << ", copy on default: " << ft_copyDefault;
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+#endif
+
+struct	AddTo
+{
+	int		amount;
+	AddTo(int n) : amount(n) {}
+	void	operator()(int& value) const { value += amount; }
+};
+
+static void	example41()
+{
+	/* Example 41 */
+	/* Example for per-key counters in an augmented map, bumped in place through update */
+
+	int		events[] = {57, 3, 57, 12, 40, 3, 57, 99, 12, 57};
+
+	std::cout << COLOR_PURPLE_B << "Example 41" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::map<int, int> mp;
+	for (int i = 0; i < 10; ++i)
+		mp[events[i]] += 10;
+	mp[57] += 10;
+	int sum = 0;
+	for (std::map<int, int>::iterator it = mp.lower_bound(10); it != mp.lower_bound(60); ++it)
+		sum += it->second;
+	std::cout << "std::map -> size: " << mp.size() << ", counter 57: " << mp[57] << ", sum [10, 60): " << sum;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	ft::map<int, int, ft::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::avl_balance, ft::sum_augment<int> >	ft_mp;
+	for (int i = 0; i < 10; ++i)
+		ft_mp.update(events[i], AddTo(10));
+	ft_mp.update(57, AddTo(10));
+	std::cout << "ft::map  -> size: " << ft_mp.size() << ", counter 57: " << ft_mp.at(57)
+		<< ", sum [10, 60): " << ft_mp.aggregate(10, 60);
+	std::cout << '.' << COLOR_END << std::endl << std::endl;
+}
+
 void	map_test()
 {
 	example1();
@@ -1608,6 +2428,29 @@ void	map_test()
 	example20();
 	example21();
 	example22();
+	example23();
+	example24();
+	example25();
+	example26();
+	example27();
+	example28();
+	example29();
+	example30();
+	example31();
+	example32();
+	example33();
+	example34();
+	example35();
+	example36();
+	example37();
+#if __cplusplus >= 201703L
+	example38();
+#endif
+	example39();
+#if __cplusplus >= 201703L
+	example40();
+#endif
+	example41();
 }
 
 #endif
@@ -0,0 +1,515 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   memory_resource.hpp                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:48:03 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 16:48:03 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace ft
+{
+	// Where a polymorphic_allocator takes its memory from. Resources are chosen at run
+	// time, so containers of one type can live in an arena, a pool or the heap.
+	class memory_resource
+	{
+		public:
+			static const std::size_t	max_align = alignof(std::max_align_t);
+
+			virtual ~memory_resource() {}
+
+			void* allocate(std::size_t bytes, std::size_t alignment = max_align)
+			{ return do_allocate(bytes, alignment); }
+
+			void deallocate(void* p, std::size_t bytes, std::size_t alignment = max_align)
+			{ do_deallocate(p, bytes, alignment); }
+
+			bool is_equal(const memory_resource& other) const { return do_is_equal(other); }
+
+		protected:
+			virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+			virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+			virtual bool do_is_equal(const memory_resource& other) const { return this == &other; }
+	};
+
+	inline bool operator==(const memory_resource& a, const memory_resource& b)
+	{ return &a == &b || a.is_equal(b); }
+
+	inline bool operator!=(const memory_resource& a, const memory_resource& b)
+	{ return !(a == b); }
+
+	// Plain operator new and delete. Before C++17 there is no aligned operator new, an
+	// over-aligned block is then cut from a bigger one whose start is kept just below it.
+	class new_delete_resource_type : public memory_resource
+	{
+		protected:
+			void* do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				if (alignment <= max_align)
+					return ::operator new(bytes);
+#if __cplusplus >= 201703L
+				return ::operator new(bytes, std::align_val_t(alignment));
+#else
+				char* raw = static_cast<char*>(::operator new(bytes + alignment + sizeof(void*)));
+				std::size_t start = reinterpret_cast<std::size_t>(raw + sizeof(void*));
+				char* p = raw + sizeof(void*) + (alignment - start % alignment) % alignment;
+				reinterpret_cast<void**>(p)[-1] = raw;
+				return p;
+#endif
+			}
+
+			void do_deallocate(void* p, std::size_t, std::size_t alignment)
+			{
+				if (alignment <= max_align)
+					::operator delete(p);
+				else
+#if __cplusplus >= 201703L
+					::operator delete(p, std::align_val_t(alignment));
+#else
+					::operator delete(static_cast<void**>(p)[-1]);
+#endif
+			}
+	};
+
+	// Refuses every request, as the upstream of an arena that must never spill.
+	class null_resource_type : public memory_resource
+	{
+		protected:
+			void* do_allocate(std::size_t, std::size_t) { throw std::bad_alloc(); }
+			void do_deallocate(void*, std::size_t, std::size_t) {}
+	};
+
+	inline memory_resource* new_delete_resource()
+	{
+		static new_delete_resource_type resource;
+		return &resource;
+	}
+
+	inline memory_resource* null_memory_resource()
+	{
+		static null_resource_type resource;
+		return &resource;
+	}
+
+	inline memory_resource*& defaultResourceSlot()
+	{
+		static memory_resource* resource = new_delete_resource();
+		return resource;
+	}
+
+	// Resource of allocators built without one. Not synchronized: set it before any
+	// other thread uses containers.
+	inline memory_resource* get_default_resource() { return defaultResourceSlot(); }
+
+	inline memory_resource* set_default_resource(memory_resource* resource)
+	{
+		memory_resource* previous = defaultResourceSlot();
+		defaultResourceSlot() = resource ? resource : new_delete_resource();
+		return previous;
+	}
+
+	inline std::size_t alignUp(std::size_t n, std::size_t alignment)
+	{
+		return (n + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Bump arena. Hands out memory by moving a cursor through a buffer, then through
+	// chunks from upstream, each twice as large as the last. deallocate() does nothing:
+	// everything goes back at once on release() or destruction, which is what makes it
+	// the cheapest way to build containers that die together. reset() frees everything
+	// too but keeps the largest chunk for the next round, so an arena reset after each
+	// request stops calling upstream once it has seen the biggest one. Not synchronized.
+	class monotonic_buffer_resource : public memory_resource
+	{
+		public:
+			explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource()) :
+			m_upstream(upstream), m_buffer(0), m_bufferSize(0), m_cur(0), m_end(0), m_chunks(0),
+			m_spare(0), m_initialSize(1024), m_nextSize(1024) {}
+
+			explicit monotonic_buffer_resource(std::size_t initialSize,
+			memory_resource* upstream = get_default_resource()) :
+			m_upstream(upstream), m_buffer(0), m_bufferSize(0), m_cur(0), m_end(0), m_chunks(0),
+			m_spare(0), m_initialSize(initialSize > 64 ? initialSize : 64), m_nextSize(m_initialSize) {}
+
+			// Starts in the given buffer, which must outlive the resource.
+			monotonic_buffer_resource(void* buffer, std::size_t size,
+			memory_resource* upstream = get_default_resource()) :
+			m_upstream(upstream), m_buffer(static_cast<char*>(buffer)), m_bufferSize(size),
+			m_cur(m_buffer), m_end(m_buffer + size), m_chunks(0), m_spare(0),
+			m_initialSize(size > 512 ? size * 2 : 1024), m_nextSize(m_initialSize) {}
+
+			~monotonic_buffer_resource() { release(); }
+
+			// Gives every chunk back upstream and starts over in the initial buffer. All
+			// memory handed out so far becomes invalid at once.
+			void release()
+			{
+				reset();
+				if (m_spare)
+					m_upstream->deallocate(m_spare, m_spare->size, max_align);
+				m_spare = 0;
+				m_nextSize = m_initialSize;
+			}
+
+			// Same, but keeps the largest chunk to be used again once the buffer is full.
+			void reset()
+			{
+				if (m_chunks)
+				{
+					if (m_spare)
+						m_upstream->deallocate(m_spare, m_spare->size, max_align);
+					m_spare = m_chunks;
+					m_chunks = m_chunks->next;
+				}
+				while (m_chunks)
+				{
+					Chunk* next = m_chunks->next;
+					m_upstream->deallocate(m_chunks, m_chunks->size, max_align);
+					m_chunks = next;
+				}
+				m_cur = m_buffer;
+				m_end = m_buffer + m_bufferSize;
+			}
+
+			memory_resource* upstream_resource() const { return m_upstream; }
+
+		protected:
+			void* do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				char* p = alignPointer(m_cur, alignment);
+				if (!m_cur || p + bytes > m_end)
+				{
+					newChunk(bytes + alignment);
+					p = alignPointer(m_cur, alignment);
+				}
+				m_cur = p + bytes;
+				return p;
+			}
+
+			void do_deallocate(void*, std::size_t, std::size_t) {}
+
+		private:
+			struct Chunk
+			{
+				Chunk*		next;
+				std::size_t	size;
+			};
+
+			memory_resource*	m_upstream;
+			char*				m_buffer;
+			std::size_t			m_bufferSize;
+			char*				m_cur;
+			char*				m_end;
+			Chunk*				m_chunks;
+			Chunk*				m_spare;
+			std::size_t			m_initialSize;
+			std::size_t			m_nextSize;
+
+			monotonic_buffer_resource(const monotonic_buffer_resource&);
+			monotonic_buffer_resource& operator=(const monotonic_buffer_resource&);
+
+			static char* alignPointer(char* p, std::size_t alignment)
+			{
+				return reinterpret_cast<char*>(alignUp(reinterpret_cast<std::size_t>(p), alignment));
+			}
+
+			void newChunk(std::size_t bytes)
+			{
+				std::size_t header = alignUp(sizeof(Chunk), max_align);
+				Chunk* chunk = m_spare;
+				m_spare = 0;
+				if (chunk && chunk->size < bytes + header)
+				{
+					m_upstream->deallocate(chunk, chunk->size, max_align);
+					chunk = 0;
+				}
+				std::size_t size = chunk ? chunk->size : m_nextSize;
+				while (size < bytes + header)
+					size *= 2;
+				if (!chunk)
+					chunk = static_cast<Chunk*>(m_upstream->allocate(size, max_align));
+				chunk->next = m_chunks;
+				chunk->size = size;
+				m_chunks = chunk;
+				m_cur = reinterpret_cast<char*>(chunk) + header;
+				m_end = reinterpret_cast<char*>(chunk) + size;
+				m_nextSize = size * 2;
+			}
+	};
+
+	// Limits of an unsynchronized_pool_resource.
+	struct pool_options
+	{
+		std::size_t	max_blocks_per_chunk;
+		std::size_t	largest_required_pool_block;
+
+		pool_options() : max_blocks_per_chunk(1024), largest_required_pool_block(4096) {}
+	};
+
+	// Pools of fixed-size blocks, one per power of two up to the largest pool block. A
+	// freed block goes back to its pool's free list for the next request of that size,
+	// so memory is reused, unlike in an arena. Each pool grows by chunks from upstream,
+	// twice as many blocks each time up to max_blocks_per_chunk. Larger or over-aligned
+	// requests go straight upstream. Everything returns upstream on release() or
+	// destruction. Not synchronized.
+	class unsynchronized_pool_resource : public memory_resource
+	{
+		public:
+			explicit unsynchronized_pool_resource(memory_resource* upstream = get_default_resource()) :
+			m_upstream(upstream), m_large(0)
+			{
+				init(pool_options());
+			}
+
+			unsynchronized_pool_resource(const pool_options& options,
+			memory_resource* upstream = get_default_resource()) :
+			m_upstream(upstream), m_large(0)
+			{
+				init(options);
+			}
+
+			~unsynchronized_pool_resource() { release(); }
+
+			// Gives every chunk and large block back upstream.
+			void release()
+			{
+				for (std::size_t i = 0; i < pool_count; ++i)
+				{
+					while (m_pools[i].chunks)
+					{
+						Chunk* next = m_pools[i].chunks->next;
+						m_upstream->deallocate(m_pools[i].chunks, m_pools[i].chunks->size, max_align);
+						m_pools[i].chunks = next;
+					}
+					m_pools[i].free = 0;
+					m_pools[i].nextBlocks = 16;
+				}
+				while (m_large)
+				{
+					Large* next = m_large->next;
+					m_upstream->deallocate(m_large, m_large->size, m_large->alignment);
+					m_large = next;
+				}
+			}
+
+			memory_resource* upstream_resource() const { return m_upstream; }
+			pool_options options() const { return m_options; }
+
+		protected:
+			void* do_allocate(std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t pool = poolOf(bytes, alignment);
+				if (pool == pool_count)
+					return allocateLarge(bytes, alignment);
+				Pool& p = m_pools[pool];
+				if (!p.free)
+					refill(pool);
+				Block* block = p.free;
+				p.free = block->next;
+				return block;
+			}
+
+			void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t pool = poolOf(bytes, alignment);
+				if (pool == pool_count)
+					return deallocateLarge(ptr, alignment);
+				Block* block = static_cast<Block*>(ptr);
+				block->next = m_pools[pool].free;
+				m_pools[pool].free = block;
+			}
+
+		private:
+			static const std::size_t	pool_count = 16;
+
+			struct Block
+			{
+				Block*	next;
+			};
+
+			struct Chunk
+			{
+				Chunk*		next;
+				std::size_t	size;
+			};
+
+			struct Pool
+			{
+				Block*		free;
+				Chunk*		chunks;
+				std::size_t	nextBlocks;
+			};
+
+			// Header of a large block, doubly linked so one can leave in O(1).
+			struct Large
+			{
+				Large*		next;
+				Large*		prev;
+				std::size_t	size;
+				std::size_t	alignment;
+			};
+
+			memory_resource*	m_upstream;
+			pool_options		m_options;
+			Pool				m_pools[pool_count];
+			std::size_t			m_poolCount;
+			Large*				m_large;
+
+			unsynchronized_pool_resource(const unsynchronized_pool_resource&);
+			unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&);
+
+			void init(const pool_options& options)
+			{
+				m_options = options;
+				if (m_options.max_blocks_per_chunk < 16)
+					m_options.max_blocks_per_chunk = 16;
+				m_poolCount = 0;
+				while (m_poolCount < pool_count && blockSize(m_poolCount) < m_options.largest_required_pool_block)
+					++m_poolCount;
+				if (m_poolCount < pool_count)
+					++m_poolCount;
+				for (std::size_t i = 0; i < pool_count; ++i)
+				{
+					m_pools[i].free = 0;
+					m_pools[i].chunks = 0;
+					m_pools[i].nextBlocks = 16;
+				}
+			}
+
+			static std::size_t blockSize(std::size_t pool) { return (std::size_t)8 << pool; }
+
+			// Pool serving a request, pool_count when it is too large or too aligned. Blocks
+			// of a pool are aligned to their size, up to max_align.
+			std::size_t poolOf(std::size_t bytes, std::size_t alignment) const
+			{
+				if (alignment > max_align)
+					return pool_count;
+				std::size_t need = bytes > alignment ? bytes : alignment;
+				std::size_t pool = 0;
+				while (pool < m_poolCount && blockSize(pool) < need)
+					++pool;
+				return pool < m_poolCount ? pool : pool_count;
+			}
+
+			void refill(std::size_t pool)
+			{
+				Pool& p = m_pools[pool];
+				std::size_t size = blockSize(pool);
+				std::size_t header = alignUp(sizeof(Chunk), max_align);
+				std::size_t count = p.nextBlocks;
+				Chunk* chunk = static_cast<Chunk*>(m_upstream->allocate(header + count * size, max_align));
+				chunk->next = p.chunks;
+				chunk->size = header + count * size;
+				p.chunks = chunk;
+				char* first = reinterpret_cast<char*>(chunk) + header;
+				for (std::size_t i = count; i > 0; --i)
+				{
+					Block* block = reinterpret_cast<Block*>(first + (i - 1) * size);
+					block->next = p.free;
+					p.free = block;
+				}
+				if (p.nextBlocks < m_options.max_blocks_per_chunk)
+					p.nextBlocks *= 2;
+			}
+
+			static std::size_t largeHeader(std::size_t alignment)
+			{
+				return alignUp(sizeof(Large), alignment > max_align ? alignment : max_align);
+			}
+
+			void* allocateLarge(std::size_t bytes, std::size_t alignment)
+			{
+				std::size_t header = largeHeader(alignment);
+				std::size_t align = alignment > max_align ? alignment : max_align;
+				Large* large = static_cast<Large*>(m_upstream->allocate(header + bytes, align));
+				large->size = header + bytes;
+				large->alignment = align;
+				large->prev = 0;
+				large->next = m_large;
+				if (m_large)
+					m_large->prev = large;
+				m_large = large;
+				return reinterpret_cast<char*>(large) + header;
+			}
+
+			void deallocateLarge(void* ptr, std::size_t alignment)
+			{
+				Large* large = reinterpret_cast<Large*>(static_cast<char*>(ptr) - largeHeader(alignment));
+				if (large->prev)
+					large->prev->next = large->next;
+				else
+					m_large = large->next;
+				if (large->next)
+					large->next->prev = large->prev;
+				m_upstream->deallocate(large, large->size, large->alignment);
+			}
+	};
+
+	// Allocator over a memory_resource, the default one unless given. Copies, rebinds
+	// and the containers built from it share the resource, so a map's nodes and a
+	// vector's buffer end up in the same arena. Like std::pmr, a container copy gets the
+	// default resource and assignment never changes a container's resource, so copying
+	// out of a per-request arena never ties a long-lived container to it.
+	template <typename T>
+	class polymorphic_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <typename U>
+			struct rebind { typedef polymorphic_allocator<U> other; };
+
+			polymorphic_allocator() : m_resource(get_default_resource()) {}
+			polymorphic_allocator(memory_resource* resource) : m_resource(resource) {}
+			template <typename U>
+			polymorphic_allocator(const polymorphic_allocator<U>& other) : m_resource(other.resource()) {}
+
+			pointer allocate(size_type n)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				return static_cast<pointer>(m_resource->allocate(n * sizeof(T), alignof(T)));
+			}
+
+			void deallocate(pointer p, size_type n) { m_resource->deallocate(p, n * sizeof(T), alignof(T)); }
+
+			template <typename U, typename... Args>
+			void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+			template <typename U>
+			void destroy(U* p) { p->~U(); }
+
+			size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
+			memory_resource* resource() const { return m_resource; }
+
+			// Resource of a container copy.
+			polymorphic_allocator select_on_container_copy_construction() const { return polymorphic_allocator(); }
+
+		private:
+			memory_resource*	m_resource;
+	};
+
+	template <typename T, typename U>
+	bool operator==(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b)
+	{ return *a.resource() == *b.resource(); }
+
+	template <typename T, typename U>
+	bool operator!=(const polymorphic_allocator<T>& a, const polymorphic_allocator<U>& b)
+	{ return !(a == b); }
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mmap_allocator.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:12:40 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 15:12:40 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace ft
+{
+	//   T				Type of elements.
+	//   Threshold		Size in bytes from which blocks are mapped.
+	// Allocator for huge vectors of trivially copyable elements. Blocks of Threshold bytes
+	// or more are anonymous mappings, and growing one asks the kernel to move its pages
+	// with mremap() instead of copying bytes into a new block, so a vector of gigabytes
+	// grows without holding two copies at once. Smaller blocks come from malloc and grow
+	// with realloc(). Linux only.
+	template <typename T, std::size_t Threshold = 1 << 20>
+	class mmap_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <typename U>
+			struct rebind { typedef mmap_allocator<U, Threshold> other; };
+
+			mmap_allocator() {}
+			template <typename U>
+			mmap_allocator(const mmap_allocator<U, Threshold>&) {}
+
+			pointer allocate(size_type n)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				void* p;
+				if (!mapped(n))
+					p = std::malloc(n ? n * sizeof(T) : 1);
+				else
+				{
+					p = mmap(0, mappedBytes(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+					if (p == MAP_FAILED)
+						p = 0;
+				}
+				if (!p)
+					throw std::bad_alloc();
+				return static_cast<pointer>(p);
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+				if (mapped(n))
+					munmap(p, mappedBytes(n));
+				else
+					std::free(p);
+			}
+
+			// Resizes a block of n elements to hold newN, moving its pages if it must. Null
+			// when the block changes kind, the caller then copies.
+			pointer reallocate(pointer p, size_type n, size_type newN)
+			{
+				if (newN > max_size() || mapped(n) != mapped(newN))
+					return 0;
+				void* q;
+				if (!mapped(n))
+					q = std::realloc(p, newN * sizeof(T));
+				else
+				{
+					q = mremap(p, mappedBytes(n), mappedBytes(newN), MREMAP_MAYMOVE);
+					if (q == MAP_FAILED)
+						q = 0;
+				}
+				return static_cast<pointer>(q);
+			}
+
+			template <typename U, typename... Args>
+			void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+			template <typename U>
+			void destroy(U* p) { p->~U(); }
+
+			size_type max_size() const { return static_cast<size_type>(-1) / 2 / sizeof(T); }
+
+			// Whether a block of n elements is a mapping, and the bytes it maps.
+			static bool mapped(size_type n) { return n * sizeof(T) >= Threshold; }
+			static size_type mappedBytes(size_type n) { return (n * sizeof(T) + page() - 1) / page() * page(); }
+
+			bool operator==(const mmap_allocator&) const { return true; }
+			bool operator!=(const mmap_allocator&) const { return false; }
+
+		private:
+			static size_type page()
+			{
+				static const size_type size = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+				return size;
+			}
+	};
+
+	template <typename T, std::size_t Threshold>
+	struct allocator_realloc<ft::mmap_allocator<T, Threshold> >
+	{
+		static const bool value = true;
+		static const bool stable = false;
+
+		static T* reallocate(ft::mmap_allocator<T, Threshold>& alloc, T* p, std::size_t n, std::size_t newN)
+		{
+			return alloc.reallocate(p, n, newN);
+		}
+	};
+
+	// A mapping holds whole pages.
+	template <typename T, std::size_t Threshold>
+	struct allocator_slack<ft::mmap_allocator<T, Threshold> >
+	{
+		static std::size_t usable(const ft::mmap_allocator<T, Threshold>&, T*, std::size_t n)
+		{
+			if (!ft::mmap_allocator<T, Threshold>::mapped(n))
+				return n;
+			return ft::mmap_allocator<T, Threshold>::mappedBytes(n) / sizeof(T);
+		}
+	};
+}
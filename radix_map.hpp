@@ -0,0 +1,1121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   radix_map.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:12:40 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 15:12:40 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string.h>
+#include <stdint.h>
+#ifdef __SSE2__
+# include <emmintrin.h>
+#endif
+#include "map_iterator.hpp"
+
+namespace ft
+{
+	// Radix key traits.
+	// Spell a key as a byte string whose lexicographic order (a proper prefix first) is
+	// the key order. Integers are written big-endian with the sign bit flipped.
+	template <typename Key>
+	struct radix_key_traits
+	{
+		static size_t size(const Key&) { return sizeof(Key); }
+
+		static unsigned char at(const Key& key, size_t i)
+		{
+			unsigned long long bits = static_cast<unsigned long long>(key);
+			if (Key(-1) < Key(0))
+				bits ^= 1ULL << (sizeof(Key) * 8 - 1);
+			return static_cast<unsigned char>(bits >> (8 * (sizeof(Key) - 1 - i)));
+		}
+	};
+
+	// Strings are their own bytes, compared as unsigned char like std::string does.
+	template <typename Traits, typename Alloc>
+	struct radix_key_traits<std::basic_string<char, Traits, Alloc> >
+	{
+		static size_t size(const std::basic_string<char, Traits, Alloc>& key) { return key.size(); }
+
+		static unsigned char at(const std::basic_string<char, Traits, Alloc>& key, size_t i)
+		{
+			return static_cast<unsigned char>(key[i]);
+		}
+	};
+
+	// Radix nodes.
+	// Every node starts with its type. Inner nodes hold a compressed path: prefixLen
+	// bytes that all keys below share, the first maxPrefix of them inline, the rest
+	// read back from any leaf below when needed. A key that ends on a node hangs from
+	// its terminal slot, which sorts before every child.
+	struct RadixBase
+	{
+		enum { leaf, node4, node16, node48, node256 };
+		enum { maxPrefix = 8 };
+
+		unsigned char	type;
+	};
+
+	struct RadixInner : RadixBase
+	{
+		uint16_t		count;
+		uint32_t		prefixLen;
+		unsigned char	prefix[maxPrefix];
+		RadixBase*		terminal;
+	};
+
+	// Up to 4 children, keys sorted.
+	struct RadixNode4 : RadixInner
+	{
+		unsigned char	keys[4];
+		RadixBase*		children[4];
+	};
+
+	// Up to 16 children, keys sorted and searched 16 at a time.
+	struct RadixNode16 : RadixInner
+	{
+		unsigned char	keys[16];
+		RadixBase*		children[16];
+	};
+
+	// Up to 48 children, reached through a 256-entry index holding slot + 1.
+	struct RadixNode48 : RadixInner
+	{
+		unsigned char	index[256];
+		RadixBase*		children[48];
+	};
+
+	// One slot per byte.
+	struct RadixNode256 : RadixInner
+	{
+		RadixBase*		children[256];
+	};
+
+	// Leaves keep the whole element and are chained in key order for iteration.
+	template <typename T>
+	struct RadixLeaf : RadixBase
+	{
+		RadixLeaf*		prev;
+		RadixLeaf*		next;
+		T				content;
+	};
+
+	//   key     		Type of keys, an integer or a std::string.
+	//   T       	 	Type of elements.
+	//   Traits			Byte spelling of the keys, see ft::radix_key_traits.
+	//   Allocator		Object used to manage the pairs.
+	// Adaptive radix tree: a lookup reads each key byte once instead of comparing the
+	// whole key at every level, and shared prefixes are stored and checked once. Inner
+	// nodes grow from 4 to 16, 48 and 256 children and shrink back as keys leave.
+	// Iterates in the order of the key bytes, which for integers and strings is the
+	// order of ft::less.
+	template<
+		typename Key,
+		typename T,
+		typename Traits = ft::radix_key_traits<Key>,
+		typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class radix_map
+	{
+			typedef RadixBase									Base;
+			typedef RadixInner									Inner;
+			typedef ft::RadixLeaf<ft::pair<const Key, T> >		Leaf;
+
+		public:
+
+			// Member Type.
+			typedef Key									key_type;
+			typedef T									mapped_type;
+			typedef Allocator							allocator_type;
+			typedef ft::pair<const Key, T>				value_type;
+			typedef long int							difference_type;
+			typedef size_t								size_type;
+
+		private:
+
+			// Iterator.
+			// B			Boolean to indicate if it's an iterator / a const iterator.
+			template <bool B>
+			class basic_iterator
+			{
+				public:
+					typedef typename radix_map::value_type										value_type;
+					typedef long int															difference_type;
+					typedef std::bidirectional_iterator_tag										iterator_category;
+					typedef typename chooseConst<B, value_type&, const value_type&>::type		reference;
+					typedef typename chooseConst<B, value_type*, const value_type*>::type		pointer;
+				private:
+					const radix_map*	m_map;
+					Leaf*				m_leaf;
+				public:
+					basic_iterator(const radix_map* map = 0, Leaf* leaf = 0) :
+						m_map(map), m_leaf(leaf) {}
+					basic_iterator(const basic_iterator<false>& copy) :
+						m_map(copy.getMap()), m_leaf(copy.getLeaf()) {}
+
+					const radix_map* getMap() const { return m_map; }
+					Leaf* getLeaf() const { return m_leaf; }
+
+					reference operator*() const { return m_leaf->content; }
+					pointer operator->() const { return &m_leaf->content; }
+
+					basic_iterator& operator++()
+					{
+						m_leaf = m_leaf->next;
+						return (*this);
+					}
+
+					basic_iterator operator++(int)
+					{
+						basic_iterator tmp(*this);
+						++(*this);
+						return (tmp);
+					}
+
+					basic_iterator& operator--()
+					{
+						m_leaf = m_leaf ? m_leaf->prev : m_map->m_tail;
+						return (*this);
+					}
+
+					basic_iterator operator--(int)
+					{
+						basic_iterator tmp(*this);
+						--(*this);
+						return (tmp);
+					}
+
+					bool operator==(const basic_iterator& it) const { return (it.m_leaf == m_leaf); }
+					bool operator!=(const basic_iterator& it) const { return (it.m_leaf != m_leaf); }
+			};
+
+		public:
+
+			typedef basic_iterator<false>				iterator;
+			typedef basic_iterator<true>				const_iterator;
+
+		private:
+
+			// Attributes.
+			Base*					m_root;
+			Leaf*					m_head;
+			Leaf*					m_tail;
+			size_type				m_size;
+			allocator_type			m_allocPair;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			explicit radix_map(const Allocator& alloc = Allocator()) :
+			m_root(0), m_head(0), m_tail(0), m_size(0), m_allocPair(alloc) {}
+
+			// Range.
+			template<typename InputIterator>
+			radix_map(InputIterator first, InputIterator last, const Allocator& alloc = Allocator(),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) :
+			m_root(0), m_head(0), m_tail(0), m_size(0), m_allocPair(alloc)
+			{
+				insert(first, last);
+			}
+
+			// Copy, with the allocator other's selects for a copy.
+			radix_map(const radix_map& other) :
+			radix_map(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_allocPair)) {}
+
+			// Copy into storage from alloc.
+			radix_map(const radix_map& other, const Allocator& alloc) :
+			m_root(0), m_head(0), m_tail(0), m_size(0), m_allocPair(alloc)
+			{
+				insert(other.begin(), other.end());
+			}
+
+			// Operator=. Our allocator stays unless it propagates on copy assignment.
+			radix_map& operator=(const radix_map& other)
+			{
+				if (this == &other)
+					return *this;
+				radix_map tmp(other, std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value
+					? other.m_allocPair : m_allocPair);
+				this->swap(tmp);
+				return *this;
+			}
+
+			// Destroy.
+			~radix_map() { clear(); }
+
+// __ Iterators
+
+			iterator begin()					{ return iterator(this, m_head); }
+			const_iterator begin() const		{ return const_iterator(this, m_head); }
+			iterator end()						{ return iterator(this, 0); }
+			const_iterator end() const			{ return const_iterator(this, 0); }
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return m_size == 0; }
+
+			// Size.
+			size_type size() const 		{ return m_size; }
+
+			// Max.
+			size_type max_size() const	{ return std::allocator<Leaf>().max_size(); }
+
+// __ Element Access
+
+			// At
+			T& at(const Key& key)
+			{
+				Leaf* leaf = searchLeaf(key);
+				if (!leaf)
+					throw std::out_of_range("radix_map::at: key not found");
+				return leaf->content.second;
+			}
+
+			// At (const)
+			const T& at(const Key& key) const
+			{
+				Leaf* leaf = searchLeaf(key);
+				if (!leaf)
+					throw std::out_of_range("radix_map::at: key not found");
+				return leaf->content.second;
+			}
+
+			// Operator []
+			T& operator[](const Key& key)
+			{
+				Leaf* next = lowerBound(key);
+				if (next && sameKey(next->content.first, key))
+					return next->content.second;
+				return insertLeaf(value_type(key, T()), next)->content.second;
+			}
+
+// __ Modifiers
+
+			// Insert one element.
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				Leaf* next = lowerBound(val.first);
+				if (next && sameKey(next->content.first, val.first))
+					return ft::pair<iterator, bool>(iterator(this, next), false);
+				return ft::pair<iterator, bool>(iterator(this, insertLeaf(val, next)), true);
+			}
+
+			// Inserts all elements.
+			template <typename InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Removes one element.
+			void erase(iterator position)
+			{
+				eraseLeaf(position->first);
+			}
+
+			// Removes one element on a specific key.
+			size_type erase(const Key& key)
+			{
+				return eraseLeaf(key) ? 1 : 0;
+			}
+
+			// Removes a range of elements.
+			void erase(iterator first, iterator last)
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			// Swaps the content of this one.
+			void swap(radix_map& other)
+			{
+				swap(m_root, other.m_root);
+				swap(m_head, other.m_head);
+				swap(m_tail, other.m_tail);
+				swap(m_size, other.m_size);
+				swap(m_allocPair, other.m_allocPair);
+			}
+
+			// Removes all elements.
+			void clear()
+			{
+				destroyTree(m_root);
+				m_root = 0;
+				m_head = 0;
+				m_tail = 0;
+				m_size = 0;
+			}
+
+// __ Operations
+
+			// Searches the container for an element.
+			iterator find(const Key& key)				{ return iterator(this, searchLeaf(key)); }
+			const_iterator find(const Key& key) const	{ return const_iterator(this, searchLeaf(key)); }
+
+			// Count elements with a specific key.
+			size_type count(const Key& key) const		{ return searchLeaf(key) ? 1 : 0; }
+
+			// Return the element whose key is not considered to go before key.
+			iterator lower_bound(const Key& key)				{ return iterator(this, lowerBound(key)); }
+			const_iterator lower_bound(const Key& key) const	{ return const_iterator(this, lowerBound(key)); }
+
+			// Return for the element whose key is considered to go after key.
+			iterator upper_bound(const Key& key)				{ return iterator(this, upperBound(key)); }
+			const_iterator upper_bound(const Key& key) const	{ return const_iterator(this, upperBound(key)); }
+
+			// Returns the bounds of a range.
+			ft::pair<iterator, iterator> equal_range(const Key& key)
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+// __ Allocator
+
+			allocator_type get_allocator() const { return m_allocPair; }
+
+		private:
+
+			// Swap.
+			template <typename U>
+			void swap(U& a, U& b)
+			{
+				U tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+// __ Keys
+
+			static bool isLeaf(const Base* node) { return node->type == Base::leaf; }
+
+			static const Key& keyOf(const Base* node) { return static_cast<const Leaf*>(node)->content.first; }
+
+			static bool sameKey(const Key& a, const Key& b)
+			{
+				size_t size = Traits::size(a);
+				if (Traits::size(b) != size)
+					return false;
+				for (size_t i = 0; i < size; ++i)
+					if (Traits::at(a, i) != Traits::at(b, i))
+						return false;
+				return true;
+			}
+
+			// Byte order of two keys, from byte `from` on (earlier bytes are known equal).
+			static bool keyLess(const Key& a, const Key& b, size_t from)
+			{
+				size_t sizeA = Traits::size(a);
+				size_t sizeB = Traits::size(b);
+				for (size_t i = from; i < sizeA && i < sizeB; ++i)
+				{
+					unsigned char x = Traits::at(a, i);
+					unsigned char y = Traits::at(b, i);
+					if (x != y)
+						return x < y;
+				}
+				return sizeA < sizeB;
+			}
+
+			// Byte i of the node's prefix; past the inline bytes it comes from a leaf below,
+			// whose key is read starting at the node's depth.
+			static unsigned char prefixByte(const Inner* node, size_t i, const Key& below, size_t depth)
+			{
+				return i < Base::maxPrefix ? node->prefix[i] : Traits::at(below, depth + i);
+			}
+
+			// How many bytes of the node's prefix the key matches from depth.
+			static size_t prefixMatch(const Inner* node, const Key& key, size_t depth)
+			{
+				size_t size = Traits::size(key);
+				const Key* below = 0;
+				for (size_t i = 0; i < node->prefixLen; ++i)
+				{
+					if (depth + i == size)
+						return i;
+					if (i == Base::maxPrefix)
+						below = &keyOf(minLeaf(node));
+					if (Traits::at(key, depth + i) != prefixByte(node, i, below ? *below : key, depth))
+						return i;
+				}
+				return node->prefixLen;
+			}
+
+			// Same, trusting the bytes past the inline ones: lookups confirm on the leaf.
+			static bool inlinePrefixMatches(const Inner* node, const Key& key, size_t depth)
+			{
+				size_t size = Traits::size(key);
+				if (depth + node->prefixLen > size)
+					return false;
+				size_t checked = node->prefixLen;
+				if (checked > Base::maxPrefix)
+					checked = Base::maxPrefix;
+				for (size_t i = 0; i < checked; ++i)
+					if (Traits::at(key, depth + i) != node->prefix[i])
+						return false;
+				return true;
+			}
+
+			// Sets the node's prefix to len bytes of key from depth.
+			static void setPrefix(Inner* node, const Key& key, size_t depth, size_t len)
+			{
+				node->prefixLen = static_cast<uint32_t>(len);
+				for (size_t i = 0; i < len && i < Base::maxPrefix; ++i)
+					node->prefix[i] = Traits::at(key, depth + i);
+			}
+
+// __ Nodes
+
+			template <typename N>
+			static N* newInner(unsigned char type)
+			{
+				N* node = std::allocator<N>().allocate(1);
+				memset(static_cast<void*>(node), 0, sizeof(N));
+				node->type = type;
+				return node;
+			}
+
+			// Frees an inner node of any size.
+			static void freeInner(Inner* node)
+			{
+				switch (node->type)
+				{
+					case Base::node4: std::allocator<RadixNode4>().deallocate(static_cast<RadixNode4*>(node), 1); break;
+					case Base::node16: std::allocator<RadixNode16>().deallocate(static_cast<RadixNode16*>(node), 1); break;
+					case Base::node48: std::allocator<RadixNode48>().deallocate(static_cast<RadixNode48*>(node), 1); break;
+					default: std::allocator<RadixNode256>().deallocate(static_cast<RadixNode256*>(node), 1); break;
+				}
+			}
+
+			Leaf* createLeaf(const value_type& val)
+			{
+				Leaf* leaf = std::allocator<Leaf>().allocate(1);
+				try
+				{
+					m_allocPair.construct(&leaf->content, val);
+				}
+				catch (...)
+				{
+					std::allocator<Leaf>().deallocate(leaf, 1);
+					throw ;
+				}
+				leaf->type = Base::leaf;
+				leaf->prev = 0;
+				leaf->next = 0;
+				return leaf;
+			}
+
+			void destroyLeaf(Leaf* leaf)
+			{
+				m_allocPair.destroy(&leaf->content);
+				std::allocator<Leaf>().deallocate(leaf, 1);
+			}
+
+			void destroyTree(Base* node)
+			{
+				if (!node)
+					return ;
+				if (isLeaf(node))
+				{
+					destroyLeaf(static_cast<Leaf*>(node));
+					return ;
+				}
+				Inner* inner = static_cast<Inner*>(node);
+				destroyTree(inner->terminal);
+				Base** children;
+				int slots;
+				switch (inner->type)
+				{
+					case Base::node4: children = static_cast<RadixNode4*>(inner)->children; slots = inner->count; break;
+					case Base::node16: children = static_cast<RadixNode16*>(inner)->children; slots = inner->count; break;
+					case Base::node48: children = static_cast<RadixNode48*>(inner)->children; slots = 48; break;
+					default: children = static_cast<RadixNode256*>(inner)->children; slots = 256; break;
+				}
+				for (int i = 0; i < slots; ++i)
+					destroyTree(children[i]);
+				freeInner(inner);
+			}
+
+			static void copyHeader(Inner* to, const Inner* from)
+			{
+				to->count = from->count;
+				to->prefixLen = from->prefixLen;
+				memcpy(to->prefix, from->prefix, Base::maxPrefix);
+				to->terminal = from->terminal;
+			}
+
+// __ Children
+
+			// Slot of the child under byte b, null if there is none.
+			static Base** findChild(Inner* node, unsigned char b)
+			{
+				switch (node->type)
+				{
+					case Base::node4:
+					{
+						RadixNode4* n = static_cast<RadixNode4*>(node);
+						for (int i = 0; i < n->count; ++i)
+							if (n->keys[i] == b)
+								return &n->children[i];
+						return 0;
+					}
+					case Base::node16:
+					{
+						RadixNode16* n = static_cast<RadixNode16*>(node);
+#ifdef __SSE2__
+						__m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(b)),
+							_mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+						int mask = _mm_movemask_epi8(hits) & ((1 << n->count) - 1);
+						return mask ? &n->children[__builtin_ctz(mask)] : 0;
+#else
+						for (int i = 0; i < n->count; ++i)
+							if (n->keys[i] == b)
+								return &n->children[i];
+						return 0;
+#endif
+					}
+					case Base::node48:
+					{
+						RadixNode48* n = static_cast<RadixNode48*>(node);
+						return n->index[b] ? &n->children[n->index[b] - 1] : 0;
+					}
+					default:
+					{
+						RadixNode256* n = static_cast<RadixNode256*>(node);
+						return n->children[b] ? &n->children[b] : 0;
+					}
+				}
+			}
+
+			// First child under a byte above b, or from byte 0 on when first is set.
+			static Base* childFrom(const Inner* node, unsigned int b)
+			{
+				switch (node->type)
+				{
+					case Base::node4:
+					{
+						const RadixNode4* n = static_cast<const RadixNode4*>(node);
+						for (int i = 0; i < n->count; ++i)
+							if (n->keys[i] >= b)
+								return n->children[i];
+						return 0;
+					}
+					case Base::node16:
+					{
+						const RadixNode16* n = static_cast<const RadixNode16*>(node);
+						for (int i = 0; i < n->count; ++i)
+							if (n->keys[i] >= b)
+								return n->children[i];
+						return 0;
+					}
+					case Base::node48:
+					{
+						const RadixNode48* n = static_cast<const RadixNode48*>(node);
+						for (; b < 256; ++b)
+							if (n->index[b])
+								return n->children[n->index[b] - 1];
+						return 0;
+					}
+					default:
+					{
+						const RadixNode256* n = static_cast<const RadixNode256*>(node);
+						for (; b < 256; ++b)
+							if (n->children[b])
+								return n->children[b];
+						return 0;
+					}
+				}
+			}
+
+			static Base* firstChild(const Inner* node) { return childFrom(node, 0); }
+			static Base* nextChild(const Inner* node, unsigned char b) { return childFrom(node, b + 1u); }
+
+			// Byte under which child hangs in node.
+			static unsigned char lastByte(const Inner* node, const Base* child)
+			{
+				switch (node->type)
+				{
+					case Base::node4:
+					{
+						const RadixNode4* n = static_cast<const RadixNode4*>(node);
+						for (int i = 0; ; ++i)
+							if (n->children[i] == child)
+								return n->keys[i];
+					}
+					case Base::node16:
+					{
+						const RadixNode16* n = static_cast<const RadixNode16*>(node);
+						for (int i = 0; ; ++i)
+							if (n->children[i] == child)
+								return n->keys[i];
+					}
+					case Base::node48:
+					{
+						const RadixNode48* n = static_cast<const RadixNode48*>(node);
+						for (int b = 0; ; ++b)
+							if (n->index[b] && n->children[n->index[b] - 1] == child)
+								return static_cast<unsigned char>(b);
+					}
+					default:
+					{
+						const RadixNode256* n = static_cast<const RadixNode256*>(node);
+						for (int b = 0; ; ++b)
+							if (n->children[b] == child)
+								return static_cast<unsigned char>(b);
+					}
+				}
+			}
+
+			// Inserts into a sorted key array.
+			template <typename N>
+			static void addSorted(N* n, unsigned char b, Base* child)
+			{
+				int i = n->count;
+				while (i > 0 && n->keys[i - 1] > b)
+				{
+					n->keys[i] = n->keys[i - 1];
+					n->children[i] = n->children[i - 1];
+					--i;
+				}
+				n->keys[i] = b;
+				n->children[i] = child;
+				++n->count;
+			}
+
+			// Removes from a sorted key array.
+			template <typename N>
+			static void removeSorted(N* n, unsigned char b)
+			{
+				int i = 0;
+				while (n->keys[i] != b)
+					++i;
+				for (--n->count; i < n->count; ++i)
+				{
+					n->keys[i] = n->keys[i + 1];
+					n->children[i] = n->children[i + 1];
+				}
+			}
+
+			// Adds a child under byte b, moving the node to the next size when it is full.
+			// ref is the slot that points to node.
+			static void addChild(Base** ref, Inner* node, unsigned char b, Base* child)
+			{
+				switch (node->type)
+				{
+					case Base::node4:
+					{
+						RadixNode4* n = static_cast<RadixNode4*>(node);
+						if (n->count < 4)
+							return addSorted(n, b, child);
+						RadixNode16* bigger = newInner<RadixNode16>(Base::node16);
+						copyHeader(bigger, n);
+						memcpy(bigger->keys, n->keys, 4);
+						memcpy(bigger->children, n->children, 4 * sizeof(Base*));
+						freeInner(n);
+						*ref = bigger;
+						return addSorted(bigger, b, child);
+					}
+					case Base::node16:
+					{
+						RadixNode16* n = static_cast<RadixNode16*>(node);
+						if (n->count < 16)
+							return addSorted(n, b, child);
+						RadixNode48* bigger = newInner<RadixNode48>(Base::node48);
+						copyHeader(bigger, n);
+						for (int i = 0; i < 16; ++i)
+						{
+							bigger->children[i] = n->children[i];
+							bigger->index[n->keys[i]] = static_cast<unsigned char>(i + 1);
+						}
+						freeInner(n);
+						*ref = bigger;
+						return addChild(ref, bigger, b, child);
+					}
+					case Base::node48:
+					{
+						RadixNode48* n = static_cast<RadixNode48*>(node);
+						if (n->count < 48)
+						{
+							int slot = 0;
+							while (n->children[slot])
+								++slot;
+							n->children[slot] = child;
+							n->index[b] = static_cast<unsigned char>(slot + 1);
+							++n->count;
+							return ;
+						}
+						RadixNode256* bigger = newInner<RadixNode256>(Base::node256);
+						copyHeader(bigger, n);
+						for (int i = 0; i < 256; ++i)
+							if (n->index[i])
+								bigger->children[i] = n->children[n->index[i] - 1];
+						freeInner(n);
+						*ref = bigger;
+						return addChild(ref, bigger, b, child);
+					}
+					default:
+					{
+						RadixNode256* n = static_cast<RadixNode256*>(node);
+						n->children[b] = child;
+						++n->count;
+					}
+				}
+			}
+
+			// Removes the child under byte b, then moves the node to the previous size
+			// once it is sparse enough, or replaces it by its last entry.
+			static void removeChild(Base** ref, Inner* node, unsigned char b)
+			{
+				switch (node->type)
+				{
+					case Base::node4:
+						removeSorted(static_cast<RadixNode4*>(node), b);
+						break ;
+					case Base::node16:
+					{
+						RadixNode16* n = static_cast<RadixNode16*>(node);
+						removeSorted(n, b);
+						if (n->count < 3)
+						{
+							RadixNode4* smaller = newInner<RadixNode4>(Base::node4);
+							copyHeader(smaller, n);
+							memcpy(smaller->keys, n->keys, n->count);
+							memcpy(smaller->children, n->children, n->count * sizeof(Base*));
+							freeInner(n);
+							*ref = node = smaller;
+						}
+						break ;
+					}
+					case Base::node48:
+					{
+						RadixNode48* n = static_cast<RadixNode48*>(node);
+						n->children[n->index[b] - 1] = 0;
+						n->index[b] = 0;
+						if (--n->count < 12)
+						{
+							RadixNode16* smaller = newInner<RadixNode16>(Base::node16);
+							copyHeader(smaller, n);
+							smaller->count = 0;
+							for (int i = 0; i < 256; ++i)
+								if (n->index[i])
+									addSorted(smaller, static_cast<unsigned char>(i), n->children[n->index[i] - 1]);
+							freeInner(n);
+							*ref = node = smaller;
+						}
+						break ;
+					}
+					default:
+					{
+						RadixNode256* n = static_cast<RadixNode256*>(node);
+						n->children[b] = 0;
+						if (--n->count < 37)
+						{
+							RadixNode48* smaller = newInner<RadixNode48>(Base::node48);
+							copyHeader(smaller, n);
+							smaller->count = 0;
+							for (int i = 0; i < 256; ++i)
+								if (n->children[i])
+								{
+									smaller->children[smaller->count] = n->children[i];
+									smaller->index[i] = static_cast<unsigned char>(++smaller->count);
+								}
+							freeInner(n);
+							*ref = node = smaller;
+						}
+					}
+				}
+				collapse(ref, node);
+			}
+
+			// A node left with a single entry is replaced by it. An inner child takes the
+			// node's prefix and the byte it hung under in front of its own prefix.
+			static void collapse(Base** ref, Inner* node)
+			{
+				if (node->count + (node->terminal ? 1 : 0) != 1)
+					return ;
+				Base* only = node->terminal ? node->terminal : firstChild(node);
+				if (!isLeaf(only))
+				{
+					Inner* child = static_cast<Inner*>(only);
+					unsigned char merged[Base::maxPrefix];
+					size_t len = 0;
+					for (; len < node->prefixLen && len < Base::maxPrefix; ++len)
+						merged[len] = node->prefix[len];
+					if (len < Base::maxPrefix)
+						merged[len++] = lastByte(node, child);
+					for (size_t i = 0; len < Base::maxPrefix && i < child->prefixLen; ++i)
+						merged[len++] = child->prefix[i];
+					memcpy(child->prefix, merged, len);
+					child->prefixLen += node->prefixLen + 1;
+				}
+				*ref = only;
+				freeInner(node);
+			}
+
+// __ Tree
+
+			// Smallest leaf below node: a terminal comes before any child.
+			static const Leaf* minLeaf(const Base* node)
+			{
+				while (!isLeaf(node))
+				{
+					const Inner* inner = static_cast<const Inner*>(node);
+					node = inner->terminal ? inner->terminal : firstChild(inner);
+				}
+				return static_cast<const Leaf*>(node);
+			}
+
+			Leaf* searchLeaf(const Key& key) const
+			{
+				size_t size = Traits::size(key);
+				Base* node = m_root;
+				size_t depth = 0;
+				while (node && !isLeaf(node))
+				{
+					Inner* inner = static_cast<Inner*>(node);
+					if (!inlinePrefixMatches(inner, key, depth))
+						return 0;
+					depth += inner->prefixLen;
+					if (depth == size)
+					{
+						node = inner->terminal;
+						break ;
+					}
+					Base** child = findChild(inner, Traits::at(key, depth++));
+					node = child ? *child : 0;
+				}
+				if (node && sameKey(keyOf(node), key))
+					return static_cast<Leaf*>(node);
+				return 0;
+			}
+
+			// First leaf whose key is not below key. On the way down, the smallest subtree
+			// past the key's branch at the deepest level is the answer if the key falls off.
+			Leaf* lowerBound(const Key& key) const
+			{
+				size_t size = Traits::size(key);
+				const Base* node = m_root;
+				const Base* after = 0;
+				size_t depth = 0;
+				while (node)
+				{
+					if (isLeaf(node))
+					{
+						if (!keyLess(keyOf(node), key, depth))
+							return const_cast<Leaf*>(static_cast<const Leaf*>(node));
+						break ;
+					}
+					const Inner* inner = static_cast<const Inner*>(node);
+					size_t match = prefixMatch(inner, key, depth);
+					if (match < inner->prefixLen)
+					{
+						if (depth + match == size || Traits::at(key, depth + match)
+							< prefixByte(inner, match, keyOf(minLeaf(inner)), depth))
+							after = inner;
+						break ;
+					}
+					depth += inner->prefixLen;
+					if (depth == size)
+					{
+						after = inner;
+						break ;
+					}
+					unsigned char b = Traits::at(key, depth++);
+					const Base* next = nextChild(inner, b);
+					if (next)
+						after = next;
+					Base** child = findChild(const_cast<Inner*>(inner), b);
+					node = child ? *child : 0;
+				}
+				return after ? const_cast<Leaf*>(minLeaf(after)) : 0;
+			}
+
+			Leaf* upperBound(const Key& key) const
+			{
+				Leaf* leaf = lowerBound(key);
+				if (leaf && sameKey(leaf->content.first, key))
+					leaf = leaf->next;
+				return leaf;
+			}
+
+			// Hangs a leaf on node: as its terminal if the key ends at depth, else as a child.
+			static void attach(RadixNode4* node, Leaf* leaf, size_t depth)
+			{
+				const Key& key = leaf->content.first;
+				if (Traits::size(key) == depth)
+					node->terminal = leaf;
+				else
+					addSorted(node, Traits::at(key, depth), leaf);
+			}
+
+			// Links a new element into the tree, and into the leaf chain before next, its
+			// lower bound. The key is absent.
+			Leaf* insertLeaf(const value_type& val, Leaf* next)
+			{
+				Leaf* leaf = createLeaf(val);
+				try
+				{
+					placeLeaf(leaf);
+				}
+				catch (...)
+				{
+					destroyLeaf(leaf);
+					throw ;
+				}
+				leaf->next = next;
+				leaf->prev = next ? next->prev : m_tail;
+				(leaf->prev ? leaf->prev->next : m_head) = leaf;
+				(next ? next->prev : m_tail) = leaf;
+				++m_size;
+				return leaf;
+			}
+
+			// Hangs a new leaf in the tree. Each case allocates the one inner node it needs,
+			// if any, before changing a link, so a throw leaves the tree as it was.
+			void placeLeaf(Leaf* leaf)
+			{
+				const Key& key = leaf->content.first;
+				size_t size = Traits::size(key);
+				Base** ref = &m_root;
+				size_t depth = 0;
+				while (true)
+				{
+					Base* node = *ref;
+					if (!node)
+					{
+						*ref = leaf;
+						return ;
+					}
+					if (isLeaf(node))
+					{
+						const Key& other = keyOf(node);
+						size_t otherSize = Traits::size(other);
+						size_t common = 0;
+						while (depth + common < size && depth + common < otherSize
+							&& Traits::at(key, depth + common) == Traits::at(other, depth + common))
+							++common;
+						RadixNode4* split = newInner<RadixNode4>(Base::node4);
+						setPrefix(split, key, depth, common);
+						attach(split, static_cast<Leaf*>(node), depth + common);
+						attach(split, leaf, depth + common);
+						*ref = split;
+						return ;
+					}
+					Inner* inner = static_cast<Inner*>(node);
+					size_t match = prefixMatch(inner, key, depth);
+					if (match < inner->prefixLen)
+					{
+						const Key& below = keyOf(minLeaf(inner));
+						RadixNode4* split = newInner<RadixNode4>(Base::node4);
+						setPrefix(split, key, depth, match);
+						unsigned char b = prefixByte(inner, match, below, depth);
+						size_t rest = inner->prefixLen - match - 1;
+						for (size_t i = 0; i < rest && i < Base::maxPrefix; ++i)
+							inner->prefix[i] = prefixByte(inner, match + 1 + i, below, depth);
+						inner->prefixLen = static_cast<uint32_t>(rest);
+						addSorted(split, b, inner);
+						attach(split, leaf, depth + match);
+						*ref = split;
+						return ;
+					}
+					depth += inner->prefixLen;
+					if (depth == size)
+					{
+						inner->terminal = leaf;
+						return ;
+					}
+					unsigned char b = Traits::at(key, depth);
+					Base** child = findChild(inner, b);
+					if (!child)
+					{
+						addChild(ref, inner, b, leaf);
+						return ;
+					}
+					ref = child;
+					++depth;
+				}
+			}
+
+			// Unlinks the element with this key from the tree and the leaf chain.
+			bool eraseLeaf(const Key& key)
+			{
+				size_t size = Traits::size(key);
+				Base** ref = &m_root;
+				Base* node = m_root;
+				size_t depth = 0;
+				if (!node)
+					return false;
+				if (isLeaf(node))
+				{
+					if (!sameKey(keyOf(node), key))
+						return false;
+					m_root = 0;
+					return unlinkLeaf(static_cast<Leaf*>(node));
+				}
+				while (true)
+				{
+					Inner* inner = static_cast<Inner*>(node);
+					if (!inlinePrefixMatches(inner, key, depth))
+						return false;
+					depth += inner->prefixLen;
+					if (depth == size)
+					{
+						Base* leaf = inner->terminal;
+						if (!leaf || !sameKey(keyOf(leaf), key))
+							return false;
+						inner->terminal = 0;
+						collapse(ref, inner);
+						return unlinkLeaf(static_cast<Leaf*>(leaf));
+					}
+					unsigned char b = Traits::at(key, depth++);
+					Base** child = findChild(inner, b);
+					if (!child)
+						return false;
+					if (isLeaf(*child))
+					{
+						Base* leaf = *child;
+						if (!sameKey(keyOf(leaf), key))
+							return false;
+						removeChild(ref, inner, b);
+						return unlinkLeaf(static_cast<Leaf*>(leaf));
+					}
+					ref = child;
+					node = *child;
+				}
+			}
+
+			bool unlinkLeaf(Leaf* leaf)
+			{
+				(leaf->prev ? leaf->prev->next : m_head) = leaf->next;
+				(leaf->next ? leaf->next->prev : m_tail) = leaf->prev;
+				destroyLeaf(leaf);
+				--m_size;
+				return true;
+			}
+	};
+
+	// Non-member functions.
+	template <typename Key, typename T, typename Traits, typename Alloc>
+	void swap(ft::radix_map<Key, T, Traits, Alloc>& lhs, ft::radix_map<Key, T, Traits, Alloc>& rhs)
+	{
+		lhs.swap(rhs);
+	}
+}
@@ -0,0 +1,657 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   small_map.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 15:58:03 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 15:58:03 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "map.hpp"
+
+namespace ft
+{
+	// Sorted copy of the inline integer keys, padded with the largest value. A lower
+	// bound is then the count of keys below the one searched over all N slots: no
+	// branch, a fixed trip count, and compilers turn it into a few SIMD compares.
+	template <typename Key, size_t N, bool Packed>
+	struct SmallMapKeys
+	{
+		Key		keys[N];
+
+		SmallMapKeys() { clear(); }
+
+		size_t lowerBound(const Key& key) const
+		{
+			size_t below = 0;
+			for (size_t i = 0; i < N; ++i)
+				below += keys[i] < key;
+			return below;
+		}
+
+		void insert(size_t pos, size_t count, const Key& key)
+		{
+			for (size_t i = count; i > pos; --i)
+				keys[i] = keys[i - 1];
+			keys[pos] = key;
+		}
+
+		void erase(size_t pos, size_t count)
+		{
+			for (size_t i = pos; i + 1 < count; ++i)
+				keys[i] = keys[i + 1];
+			keys[count - 1] = std::numeric_limits<Key>::max();
+		}
+
+		void clear()
+		{
+			for (size_t i = 0; i < N; ++i)
+				keys[i] = std::numeric_limits<Key>::max();
+		}
+	};
+
+	// Other keys are searched in place.
+	template <typename Key, size_t N>
+	struct SmallMapKeys<Key, N, false>
+	{
+		size_t lowerBound(const Key&) const { return 0; }
+		void insert(size_t, size_t, const Key&) {}
+		void erase(size_t, size_t) {}
+		void clear() {}
+	};
+
+	//   key     		Type of keys.
+	//   T       	 	Type of elements.
+	//   N				Number of elements kept inside the object.
+	//   Compare  		Comparison object used to sort the elements.
+	//   Allocator		Object used to manage the pairs once spilled.
+	// The first N elements live sorted inside the object and are searched linearly, so
+	// a small map never touches the heap. Inserting one more moves everything into an
+	// ft::map, which is kept until clear(). Spilling invalidates iterators.
+	template<
+		typename Key,
+		typename T,
+		size_t N = 8,
+		typename Compare = ft::less<Key>,
+		typename Allocator = std::allocator<ft::pair<const Key, T> > >
+	class small_map
+	{
+		public:
+
+			// Member Type.
+			typedef Key									key_type;
+			typedef T									mapped_type;
+			typedef Compare								key_compare;
+			typedef Allocator							allocator_type;
+			typedef ft::pair<const Key, T>				value_type;
+			typedef long int							difference_type;
+			typedef size_t								size_type;
+			typedef ft::map<Key, T, Compare, Allocator>	tree_type;
+
+		private:
+
+			// Integer keys under the default ordering get the branchless search.
+			typedef SmallMapKeys<Key, N, ft::is_integral<Key>::value
+				&& ft::is_same<Compare, ft::less<Key> >::value>	Keys;
+
+			// Iterator.
+			// B			Boolean to indicate if it's an iterator / a const iterator.
+			// Walks the inline slots by index, or the tree once the map has spilled.
+			template <bool B>
+			class basic_iterator
+			{
+				public:
+					typedef typename small_map::value_type										value_type;
+					typedef long int															difference_type;
+					typedef std::bidirectional_iterator_tag										iterator_category;
+					typedef typename chooseConst<B, value_type&, const value_type&>::type		reference;
+					typedef typename chooseConst<B, value_type*, const value_type*>::type		pointer;
+				private:
+					const small_map*				m_map;
+					size_type						m_index;
+					typename tree_type::iterator	m_node;
+				public:
+					basic_iterator(const small_map* map = 0, size_type index = 0,
+						typename tree_type::iterator node = typename tree_type::iterator()) :
+						m_map(map), m_index(index), m_node(node) {}
+					basic_iterator(const basic_iterator<false>& copy) :
+						m_map(copy.getMap()), m_index(copy.getIndex()), m_node(copy.getNode()) {}
+
+					const small_map* getMap() const { return m_map; }
+					size_type getIndex() const { return m_index; }
+					typename tree_type::iterator getNode() const { return m_node; }
+
+					reference operator*() const { return m_map->m_tree ? *m_node : m_map->slot(m_index); }
+					pointer operator->() const { return &(**this); }
+
+					basic_iterator& operator++()
+					{
+						if (m_map->m_tree)
+							++m_node;
+						else
+							++m_index;
+						return (*this);
+					}
+
+					basic_iterator operator++(int)
+					{
+						basic_iterator tmp(*this);
+						++(*this);
+						return (tmp);
+					}
+
+					basic_iterator& operator--()
+					{
+						if (m_map->m_tree)
+							--m_node;
+						else
+							--m_index;
+						return (*this);
+					}
+
+					basic_iterator operator--(int)
+					{
+						basic_iterator tmp(*this);
+						--(*this);
+						return (tmp);
+					}
+
+					bool operator==(const basic_iterator& it) const
+					{
+						return m_map && m_map->m_tree ? it.m_node == m_node : it.m_index == m_index;
+					}
+					bool operator!=(const basic_iterator& it) const { return !(*this == it); }
+			};
+
+		public:
+
+			typedef basic_iterator<false>				iterator;
+			typedef basic_iterator<true>				const_iterator;
+
+		private:
+
+			// Attributes.
+			alignas(value_type) unsigned char	m_slots[N * sizeof(value_type)];
+			size_type							m_count;
+			Keys								m_keys;
+			tree_type*							m_tree;
+			key_compare							m_comp;
+			allocator_type						m_allocPair;
+
+// __ Constructors and Destructor
+
+		public:
+
+			// Default.
+			explicit small_map(const Compare& comp = Compare(), const Allocator& alloc = Allocator()) :
+			m_count(0), m_tree(0), m_comp(comp), m_allocPair(alloc) {}
+
+			// Range.
+			template<typename InputIterator>
+			small_map(InputIterator first, InputIterator last, const Compare& comp = Compare(),
+			const Allocator& alloc = Allocator(),
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0) :
+			m_count(0), m_tree(0), m_comp(comp), m_allocPair(alloc)
+			{
+				insert(first, last);
+			}
+
+			// Copy, with the allocator other's selects for a copy.
+			small_map(const small_map& other) :
+			m_count(0), m_tree(0), m_comp(other.m_comp),
+			m_allocPair(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_allocPair))
+			{
+				insert(other.begin(), other.end());
+			}
+
+			// Operator=.
+			small_map& operator=(const small_map& other)
+			{
+				if (this != &other)
+				{
+					clear();
+					m_comp = other.m_comp;
+					insert(other.begin(), other.end());
+				}
+				return *this;
+			}
+
+			// Destroy.
+			~small_map() { clear(); }
+
+// __ Iterators
+
+			iterator begin()
+			{
+				return m_tree ? iterator(this, 0, m_tree->begin()) : iterator(this, 0);
+			}
+
+			const_iterator begin() const
+			{
+				return m_tree ? const_iterator(this, 0, m_tree->begin()) : const_iterator(this, 0);
+			}
+
+			iterator end()
+			{
+				return m_tree ? iterator(this, 0, m_tree->end()) : iterator(this, m_count);
+			}
+
+			const_iterator end() const
+			{
+				return m_tree ? const_iterator(this, 0, m_tree->end()) : const_iterator(this, m_count);
+			}
+
+// __ Capacity
+
+			// Empty.
+			bool empty() const 			{ return size() == 0; }
+
+			// Size.
+			size_type size() const 		{ return m_tree ? m_tree->size() : m_count; }
+
+			// Max.
+			size_type max_size() const	{ return m_allocPair.max_size(); }
+
+			// Whether the elements still live inside the object.
+			bool is_inline() const		{ return m_tree == 0; }
+
+// __ Element Access
+
+			// At
+			T& at(const Key& key)
+			{
+				iterator it = find(key);
+				if (it == end())
+					throw std::out_of_range("small_map::at: key not found");
+				return it->second;
+			}
+
+			// At (const)
+			const T& at(const Key& key) const
+			{
+				const_iterator it = find(key);
+				if (it == end())
+					throw std::out_of_range("small_map::at: key not found");
+				return it->second;
+			}
+
+			// Operator [], builds a T() only for a missing key.
+			T& operator[](const Key& key)
+			{
+				iterator it = lower_bound(key);
+				if (it != end() && !keyLess(key, it->first))
+					return it->second;
+				return insert(value_type(key, T())).first->second;
+			}
+
+// __ Modifiers
+
+			// Insert one element, spilling into the tree when the slots are full.
+			ft::pair<iterator, bool> insert(const value_type& val)
+			{
+				if (m_tree)
+				{
+					ft::pair<typename tree_type::iterator, bool> res = m_tree->insert(val);
+					return ft::pair<iterator, bool>(iterator(this, 0, res.first), res.second);
+				}
+				size_type pos = lowerIndex(val.first);
+				if (pos < m_count && !keyLess(val.first, slot(pos).first))
+					return ft::pair<iterator, bool>(iterator(this, pos), false);
+				if (m_count == N)
+				{
+					spill();
+					return insert(val);
+				}
+				insertSlot(pos, val);
+				return ft::pair<iterator, bool>(iterator(this, pos), true);
+			}
+
+			// Inserts all elements.
+			template <typename InputIterator>
+			void insert(InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
+			{
+				for (; first != last; ++first)
+					insert(*first);
+			}
+
+			// Removes one element.
+			void erase(iterator position)
+			{
+				if (m_tree)
+					m_tree->erase(position.getNode());
+				else
+					eraseSlot(position.getIndex());
+			}
+
+			// Removes one element on a specific key.
+			size_type erase(const Key& key)
+			{
+				if (m_tree)
+					return m_tree->erase(key);
+				size_type pos = lowerIndex(key);
+				if (pos == m_count || keyLess(key, slot(pos).first))
+					return 0;
+				eraseSlot(pos);
+				return 1;
+			}
+
+			// Removes a range of elements.
+			void erase(iterator first, iterator last)
+			{
+				if (m_tree)
+					m_tree->erase(first.getNode(), last.getNode());
+				else
+					for (size_type n = last.getIndex() - first.getIndex(); n > 0; --n)
+						eraseSlot(first.getIndex());
+			}
+
+			// Swaps the content of this one. Two spilled maps trade their trees: nothing is
+			// copied or allocated and iterators follow their elements into the other map.
+			// Inline elements are copied over slot by slot, which invalidates iterators to
+			// them.
+			void swap(small_map& other)
+			{
+				if (this == &other)
+					return ;
+				if (m_tree && other.m_tree)
+					std::swap(m_tree, other.m_tree);
+				else if (m_tree)
+					giveTree(other);
+				else if (other.m_tree)
+					other.giveTree(*this);
+				else
+					swapSlots(other);
+				std::swap(m_comp, other.m_comp);
+				std::swap(m_allocPair, other.m_allocPair);
+			}
+
+			// Removes all elements and goes back to inline storage.
+			void clear()
+			{
+				destroySlots();
+				if (m_tree)
+				{
+					std::allocator<tree_type> alloc;
+					alloc.destroy(m_tree);
+					alloc.deallocate(m_tree, 1);
+					m_tree = 0;
+				}
+			}
+
+// __ Observers
+
+			// Return key comparison object.
+			Compare key_comp() const { return m_comp; }
+
+// __ Operations
+
+			// Searches the container for an element.
+			iterator find(const Key& key)
+			{
+				if (m_tree)
+					return iterator(this, 0, m_tree->find(key));
+				size_type pos = lowerIndex(key);
+				return iterator(this, pos < m_count && !keyLess(key, slot(pos).first) ? pos : m_count);
+			}
+
+			const_iterator find(const Key& key) const
+			{
+				return const_cast<small_map*>(this)->find(key);
+			}
+
+			// Count elements with a specific key.
+			size_type count(const Key& key) const
+			{
+				return find(key) == end() ? 0 : 1;
+			}
+
+			// Return the element whose key is not considered to go before key.
+			iterator lower_bound(const Key& key)
+			{
+				if (m_tree)
+					return iterator(this, 0, m_tree->lower_bound(key));
+				return iterator(this, lowerIndex(key));
+			}
+
+			const_iterator lower_bound(const Key& key) const
+			{
+				return const_cast<small_map*>(this)->lower_bound(key);
+			}
+
+			// Return for the element whose key is considered to go after key.
+			iterator upper_bound(const Key& key)
+			{
+				if (m_tree)
+					return iterator(this, 0, m_tree->upper_bound(key));
+				size_type pos = lowerIndex(key);
+				if (pos < m_count && !keyLess(key, slot(pos).first))
+					++pos;
+				return iterator(this, pos);
+			}
+
+			const_iterator upper_bound(const Key& key) const
+			{
+				return const_cast<small_map*>(this)->upper_bound(key);
+			}
+
+			// Returns the bounds of a range.
+			ft::pair<iterator, iterator> equal_range(const Key& key)
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+			ft::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+			{
+				return ft::make_pair(lower_bound(key), upper_bound(key));
+			}
+
+// __ Allocator
+
+			allocator_type get_allocator() const { return m_allocPair; }
+
+// __ Inline Slots
+
+		private:
+
+			value_type& slot(size_type i) const
+			{
+				return const_cast<value_type*>(reinterpret_cast<const value_type*>(m_slots))[i];
+			}
+
+			// Strict ordering of two keys, whatever kind of comparator the map holds.
+			bool keyLess(const Key& a, const Key& b) const
+			{
+				return ft::key_order<Compare, Key>::less(m_comp, a, b);
+			}
+
+			// First slot whose key is not below key.
+			size_type lowerIndex(const Key& key) const
+			{
+				if (ft::is_integral<Key>::value && ft::is_same<Compare, ft::less<Key> >::value)
+					return m_keys.lowerBound(key);
+				size_type pos = 0;
+				while (pos < m_count && keyLess(slot(pos).first, key))
+					++pos;
+				return pos;
+			}
+
+			// Overwrites a live slot. Keys are const to users only, the map reorders its
+			// own slots.
+			void assignSlot(size_type to, const value_type& val)
+			{
+				const_cast<Key&>(slot(to).first) = val.first;
+				slot(to).second = val.second;
+			}
+
+			void moveSlot(size_type from, size_type to)
+			{
+				const_cast<Key&>(slot(to).first) = std::move(const_cast<Key&>(slot(from).first));
+				slot(to).second = std::move(slot(from).second);
+			}
+
+			// Shifting the slots only assigns live ones, the new last slot is the only one
+			// constructed and the erased last slot the only one destroyed, so no slot is
+			// ever left empty. A throwing assignment may leave a key twice, the slots are
+			// then cleared, as std::flat_map does.
+			void insertSlot(size_type pos, const value_type& val)
+			{
+				if (pos == m_count)
+				{
+					pushSlot(val);
+					return ;
+				}
+				m_allocPair.construct(&slot(m_count), slot(m_count - 1));
+				m_keys.insert(pos, m_count, val.first);
+				++m_count;
+				try
+				{
+					for (size_type i = m_count - 2; i > pos; --i)
+						moveSlot(i - 1, i);
+					assignSlot(pos, val);
+				}
+				catch (...)
+				{
+					destroySlots();
+					throw ;
+				}
+			}
+
+			void eraseSlot(size_type pos)
+			{
+				try
+				{
+					for (size_type i = pos + 1; i < m_count; ++i)
+						moveSlot(i, i - 1);
+				}
+				catch (...)
+				{
+					destroySlots();
+					throw ;
+				}
+				m_allocPair.destroy(&slot(m_count - 1));
+				m_keys.erase(pos, m_count);
+				--m_count;
+			}
+
+			// Appends a copy of an element, in order, to the inline slots.
+			void pushSlot(const value_type& val)
+			{
+				m_allocPair.construct(&slot(m_count), val);
+				m_keys.insert(m_count, m_count, val.first);
+				++m_count;
+			}
+
+			void destroySlots()
+			{
+				for (size_type i = 0; i < m_count; ++i)
+					m_allocPair.destroy(&slot(i));
+				m_count = 0;
+				m_keys.clear();
+			}
+
+			// This map is spilled and other is inline. Other's elements are copied into
+			// our free slots first, so a throwing copy leaves both maps as they were, then
+			// the tree goes to other.
+			void giveTree(small_map& other)
+			{
+				try
+				{
+					for (size_type i = 0; i < other.m_count; ++i)
+						pushSlot(other.slot(i));
+				}
+				catch (...)
+				{
+					destroySlots();
+					throw ;
+				}
+				other.destroySlots();
+				other.m_tree = m_tree;
+				m_tree = 0;
+			}
+
+			// Both maps are inline. Our elements are set aside, other's are copied into our
+			// slots, then ours into other's. Each map stays sorted whatever copy throws, but
+			// it may then hold only part of its new elements.
+			void swapSlots(small_map& other)
+			{
+				alignas(value_type) unsigned char	buffer[N * sizeof(value_type)];
+				value_type*	saved = reinterpret_cast<value_type*>(buffer);
+				size_type	count = 0;
+				try
+				{
+					for (; count < m_count; ++count)
+						m_allocPair.construct(saved + count, slot(count));
+					destroySlots();
+					for (size_type i = 0; i < other.m_count; ++i)
+						pushSlot(other.slot(i));
+					other.destroySlots();
+					for (size_type i = 0; i < count; ++i)
+						other.pushSlot(saved[i]);
+				}
+				catch (...)
+				{
+					while (count > 0)
+						m_allocPair.destroy(saved + --count);
+					throw ;
+				}
+				while (count > 0)
+					m_allocPair.destroy(saved + --count);
+			}
+
+			// Moves the inline elements into a new tree, built in one pass since they are sorted.
+			void spill()
+			{
+				std::allocator<tree_type> alloc;
+				tree_type* tree = alloc.allocate(1);
+				try
+				{
+					alloc.construct(tree, m_comp, m_allocPair);
+				}
+				catch (...)
+				{
+					alloc.deallocate(tree, 1);
+					throw ;
+				}
+				try
+				{
+					tree->bulk_load(&slot(0), &slot(0) + m_count);
+				}
+				catch (...)
+				{
+					alloc.destroy(tree);
+					alloc.deallocate(tree, 1);
+					throw ;
+				}
+				destroySlots();
+				m_tree = tree;
+			}
+	};
+
+	// Non member functions
+	template <typename Key, typename T, size_t N, typename Compare, typename Alloc>
+	void swap(ft::small_map<Key, T, N, Compare, Alloc> &lhs, ft::small_map<Key, T, N, Compare, Alloc> &rhs)
+	{ lhs.swap(rhs); }
+
+	template <typename Key, typename T, size_t N, typename Compare, typename Alloc>
+	bool operator==(const ft::small_map<Key, T, N, Compare, Alloc> &lhs, const ft::small_map<Key, T, N, Compare, Alloc> &rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::equal(lhs.begin(), lhs.end(), rhs.begin()));
+	}
+
+	template <typename Key, typename T, size_t N, typename Compare, typename Alloc>
+	bool operator!=(const ft::small_map<Key, T, N, Compare, Alloc> &lhs, const ft::small_map<Key, T, N, Compare, Alloc> &rhs)
+	{ return (!(lhs == rhs)); }
+}
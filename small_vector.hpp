@@ -0,0 +1,238 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   small_vector.hpp                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 14:05:12 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 14:05:12 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <memory>
+#include <utility>
+#include "vector.hpp"
+
+namespace ft
+{
+	// Allocator of a small_vector. Hands out the N inline slots of its owner to a request
+	// that fits while they are free, and leaves everything else to Alloc.
+	template <typename T, std::size_t N, typename Alloc>
+	class inline_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			inline_allocator(pointer slots = 0, const Alloc& alloc = Alloc()) :
+			m_heap(alloc), m_slots(slots), m_used(false) {}
+
+			pointer allocate(size_type n)
+			{
+				if (n == 0)
+					return 0;
+				if (n <= N && m_slots && !m_used)
+				{
+					m_used = true;
+					return m_slots;
+				}
+				return m_heap.allocate(n);
+			}
+
+			void deallocate(pointer p, size_type n)
+			{
+				if (p == 0)
+					return ;
+				else if (p == m_slots)
+					m_used = false;
+				else
+					m_heap.deallocate(p, n);
+			}
+
+			template <typename U, typename... Args>
+			void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+			template <typename U>
+			void destroy(U* p) { p->~U(); }
+
+			size_type max_size() const { return m_heap.max_size(); }
+
+			bool isInline(const_pointer p) const { return p == m_slots; }
+			const Alloc& heap() const { return m_heap; }
+
+		private:
+			Alloc	m_heap;
+			pointer	m_slots;
+			bool	m_used;
+	};
+
+	// The inline slots always hold N, whatever was asked for.
+	template <typename T, std::size_t N, typename Alloc>
+	struct allocator_slack<ft::inline_allocator<T, N, Alloc> >
+	{
+		static std::size_t usable(const ft::inline_allocator<T, N, Alloc>& alloc, T* p, std::size_t n)
+		{
+			if (alloc.isInline(p))
+				return N;
+			return ft::allocator_slack<Alloc>::usable(alloc.heap(), p, n);
+		}
+	};
+
+	//   T				Type of elements.
+	//   N				Number of elements kept inside the object.
+	//   Alloc			Object used to allocate once spilled.
+	//   Growth			Growth policy once spilled, see vector.hpp.
+	// An ft::vector whose first N elements live inside the object, so a short one never
+	// touches the heap. Growing past N moves everything to the heap like any reallocation,
+	// and the buffer is kept from then on. A move only steals a spilled buffer, inline
+	// elements are moved one by one.
+	template <typename T, std::size_t N, typename Alloc = std::allocator<T>, typename Growth = ft::grow_double>
+	class small_vector : public ft::vector<T, ft::inline_allocator<T, N, Alloc>, ft::grow_claim_slack<Growth> >
+	{
+		public:
+			typedef ft::vector<T, ft::inline_allocator<T, N, Alloc>, ft::grow_claim_slack<Growth> >	base_type;
+			typedef typename base_type::value_type		value_type;
+			typedef typename base_type::size_type		size_type;
+			typedef typename base_type::allocator_type	allocator_type;
+			typedef typename base_type::reference		reference;
+			typedef typename base_type::const_reference	const_reference;
+			typedef typename base_type::pointer			pointer;
+			typedef typename base_type::iterator		iterator;
+			typedef typename base_type::const_iterator	const_iterator;
+
+			static const size_type	inline_capacity = N;
+
+		private:
+			alignas(T) unsigned char	m_slots[N * sizeof(T)];
+
+// __ Constructors & Destructor
+
+		public:
+			// Default.
+			small_vector() : base_type(allocator_type(reinterpret_cast<pointer>(m_slots)))
+			{
+				this->reserve(N);
+			}
+
+			// Fill.
+			explicit small_vector(size_type n, const value_type& val = value_type()) :
+			base_type(allocator_type(reinterpret_cast<pointer>(m_slots)))
+			{
+				this->reserve(N);
+				this->assign(n, val);
+			}
+
+			// Range.
+			template <typename InputIt>
+			small_vector(InputIt first, InputIt last,
+			typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL) :
+			base_type(allocator_type(reinterpret_cast<pointer>(m_slots)))
+			{
+				this->reserve(N);
+				this->assign(first, last);
+			}
+
+			// Copy.
+			small_vector(const small_vector& other) : base_type(allocator_type(reinterpret_cast<pointer>(m_slots)))
+			{
+				this->reserve(N);
+				this->assign(other.begin(), other.end());
+			}
+
+			// Move.
+			small_vector(small_vector&& other) : base_type(allocator_type(reinterpret_cast<pointer>(m_slots)))
+			{
+				this->reserve(N);
+				take(other);
+			}
+
+			// Destroy, while the slots are still ours.
+			~small_vector() { this->clear(); }
+
+// __ Membor Functions
+
+			// Operator=.
+			small_vector& operator=(const small_vector& other)
+			{
+				if (this != &other)
+					this->assign(other.begin(), other.end());
+				return *this;
+			}
+
+			// Move assignment.
+			small_vector& operator=(small_vector&& other)
+			{
+				if (this != &other)
+					take(other);
+				return *this;
+			}
+
+			// Swap, exchanging the buffers only when both are spilled.
+			void swap(small_vector& other)
+			{
+				if (this->spilled() && other.spilled())
+				{
+					std::swap(this->m_data, other.m_data);
+					std::swap(this->m_size, other.m_size);
+					std::swap(this->m_capacity, other.m_capacity);
+					return ;
+				}
+				small_vector tmp(std::move(other));
+				other = std::move(*this);
+				*this = std::move(tmp);
+			}
+
+			// Shrink to fit, back into the slots when the elements fit there. Inline
+			// elements stay where they are.
+			void shrink_to_fit()
+			{
+				if (!spilled())
+					return ;
+				base_type::shrink_to_fit();
+				if (!this->m_data)
+					this->reserve(N);
+			}
+
+			// Whether the elements moved to the heap.
+			bool spilled() const { return this->m_data != slots(); }
+
+		private:
+			pointer slots() const { return reinterpret_cast<pointer>(const_cast<unsigned char*>(m_slots)); }
+
+			// Takes other's elements, its buffer too when spilled, and leaves it empty.
+			void take(small_vector& other)
+			{
+				this->clear();
+				if (other.spilled())
+				{
+					this->m_alloc.deallocate(this->m_data, this->m_capacity);
+					this->m_data = other.m_data;
+					this->m_size = other.m_size;
+					this->m_capacity = other.m_capacity;
+					other.m_data = 0;
+					other.m_size = 0;
+					other.m_capacity = 0;
+					other.reserve(N);
+					return ;
+				}
+				for (size_type i = 0; i < other.m_size; ++i)
+					this->emplace_back(std::move(other.m_data[i]));
+				other.clear();
+			}
+	};
+
+	template <typename T, std::size_t N, typename Alloc, typename Growth>
+	const typename small_vector<T, N, Alloc, Growth>::size_type small_vector<T, N, Alloc, Growth>::inline_capacity;
+
+	template <typename T, std::size_t N, typename Alloc, typename Growth>
+	void swap(ft::small_vector<T, N, Alloc, Growth> &x, ft::small_vector<T, N, Alloc, Growth> &y)
+	{ x.swap(y); }
+}
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stable_vector.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: miarzuma <marvin@42.fr>                    +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 16:02:27 by miarzuma          #+#    #+#             */
+/*   Updated: 2026/10/19 16:02:27 by miarzuma         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#pragma once
+
+#include <new>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "vector.hpp"
+
+namespace ft
+{
+	//   T				Type of elements.
+	//   Reserve		Bytes of address space set aside for each block.
+	// Allocator that never moves what it handed out. Each block reserves Reserve bytes
+	// of address space, inaccessible, and only makes the pages of the requested size
+	// usable. Growing makes more of them usable in place, and physical memory is only
+	// taken as those pages are first touched. A request beyond Reserve throws
+	// std::length_error rather than move the block. Linux only.
+	template <typename T, std::size_t Reserve = (std::size_t)1 << 35>
+	class reserved_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <typename U>
+			struct rebind { typedef reserved_allocator<U, Reserve> other; };
+
+			reserved_allocator() {}
+			template <typename U>
+			reserved_allocator(const reserved_allocator<U, Reserve>&) {}
+
+			pointer allocate(size_type n)
+			{
+				if (n > max_size())
+					throw std::length_error("reserved_allocator: reserved space exhausted");
+				void* p = mmap(0, Reserve, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				if (p == MAP_FAILED)
+					throw std::bad_alloc();
+				if (n && mprotect(p, committedBytes(n), PROT_READ | PROT_WRITE) != 0)
+				{
+					munmap(p, Reserve);
+					throw std::bad_alloc();
+				}
+				return static_cast<pointer>(p);
+			}
+
+			void deallocate(pointer p, size_type) { munmap(p, Reserve); }
+
+			// Opens or closes the pages up to newN elements, the block stays where it is.
+			pointer reallocate(pointer p, size_type n, size_type newN)
+			{
+				if (newN > max_size())
+					throw std::length_error("reserved_allocator: reserved space exhausted");
+				size_type from = committedBytes(n);
+				size_type to = committedBytes(newN);
+				char* base = reinterpret_cast<char*>(p);
+				if (to > from && mprotect(base + from, to - from, PROT_READ | PROT_WRITE) != 0)
+					throw std::bad_alloc();
+				// Shrinking gives the pages back and reserves them again.
+				if (to < from)
+				{
+					madvise(base + to, from - to, MADV_DONTNEED);
+					mprotect(base + to, from - to, PROT_NONE);
+				}
+				return p;
+			}
+
+			template <typename U, typename... Args>
+			void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+			template <typename U>
+			void destroy(U* p) { p->~U(); }
+
+			size_type max_size() const { return Reserve / sizeof(T); }
+
+			// Bytes made usable for n elements, whole pages.
+			static size_type committedBytes(size_type n)
+			{
+				static const size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+				return (n * sizeof(T) + page - 1) / page * page;
+			}
+
+			bool operator==(const reserved_allocator&) const { return true; }
+			bool operator!=(const reserved_allocator&) const { return false; }
+	};
+
+	template <typename T, std::size_t Reserve>
+	struct allocator_realloc<ft::reserved_allocator<T, Reserve> >
+	{
+		static const bool value = true;
+		static const bool stable = true;
+
+		static T* reallocate(ft::reserved_allocator<T, Reserve>& alloc, T* p, std::size_t n, std::size_t newN)
+		{
+			return alloc.reallocate(p, n, newN);
+		}
+	};
+
+	// The usable pages are whole.
+	template <typename T, std::size_t Reserve>
+	struct allocator_slack<ft::reserved_allocator<T, Reserve> >
+	{
+		static std::size_t usable(const ft::reserved_allocator<T, Reserve>&, T*, std::size_t n)
+		{
+			return ft::reserved_allocator<T, Reserve>::committedBytes(n) / sizeof(T);
+		}
+	};
+
+	// An ft::vector whose elements never move while it grows, up to Reserve bytes:
+	// pointers, references and iterators stay valid across push_back, emplace_back,
+	// reserve and resize. Insertions in the middle still shift the elements after them.
+	// Each one takes Reserve bytes of address space, not memory.
+	template <typename T, std::size_t Reserve = (std::size_t)1 << 35, typename Growth = ft::grow_double>
+	using stable_vector = ft::vector<T, ft::reserved_allocator<T, Reserve>, Growth>;
+}
@@ -34,9 +34,25 @@ namespace ft
 
 		public:
 			// Constructers and Destructer.
-			explicit stack(const Container& cont = Container()) { this->c = cont; }
-			stack(const stack& other) { this->c = other.c; }
-			~stack() { this->c.clear(); }
+			// The container is built in place, an empty one costs no allocation.
+			stack() : c() {}
+			explicit stack(const Container& cont) : c(cont) {}
+			stack(const stack& other) : c(other.c) {}
+
+			// With the container's allocator, e.g. a polymorphic_allocator over an arena.
+			template <typename Alloc>
+			explicit stack(const Alloc& alloc,
+			typename ft::enable_if<ft::is_same<Alloc, typename Container::allocator_type>::value>::type* = 0) :
+			c(alloc) {}
+
+			template <typename Alloc>
+			stack(const Container& cont, const Alloc& alloc,
+			typename ft::enable_if<ft::is_same<Alloc, typename Container::allocator_type>::value>::type* = 0) :
+			c(alloc)
+			{
+				this->c.insert(this->c.end(), cont.begin(), cont.end());
+			}
+			~stack() {}
 			stack& operator=(const stack& other)
 			{
 				if (this != &other)
@@ -54,28 +70,22 @@ namespace ft
 
 
 			// Non-member function.
-			template <typename U, typename Cont>
-			friend bool operator==(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator==(const stack& lhs, const stack& rhs)
 			{ return (lhs.c == rhs.c); }
 
-			template <typename U, typename Cont>
-			friend bool operator!=(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator!=(const stack& lhs, const stack& rhs)
 			{ return (lhs.c != rhs.c); }
 
-			template <typename U, typename Cont>
-			friend bool operator>(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator>(const stack& lhs, const stack& rhs)
 			{ return (lhs.c > rhs.c); }
 
-			template <typename U, typename Cont>
-			friend bool operator>=(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator>=(const stack& lhs, const stack& rhs)
 			{ return (lhs.c >= rhs.c); }
 
-			template <typename U, typename Cont>
-			friend bool operator<(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator<(const stack& lhs, const stack& rhs)
 			{ return (lhs.c < rhs.c); }
 
-			template <typename U, typename Cont>
-			friend bool operator<=(const stack<U, Cont>& lhs, const stack<U, Cont>& rhs)
+			friend bool operator<=(const stack& lhs, const stack& rhs)
 			{ return (lhs.c <= rhs.c); }
 	};
 }
@@ -5,7 +5,9 @@
 #include <deque>
 #include <stack>
 #include <stdexcept>
+#include <functional>
 #include "stack.hpp"
+#include "small_vector.hpp"
 
 #ifndef	MYCOLORS_HPP
 # define MYCOLORS_HPP
@@ -159,10 +161,58 @@ static void	example2()
 	std::cout << COLOR_END << std::endl;
 }
 
+// Whether the top element lives inside the stack object, not on the heap.
+template <typename Stack>
+static bool	topInside(const Stack& st)
+{
+	const void*	top = &st.top();
+	const char*	obj = reinterpret_cast<const char*>(&st);
+	return !std::less<const void*>()(top, obj) && std::less<const void*>()(top, obj + sizeof(st));
+}
+
+static void	example3()
+{
+	/* Example 3 */
+	/* Example for a stack over ft::small_vector: inline up to 4 elements, then on the heap */
+
+	std::stack<int, std::vector<int> >	st;
+	std::cout << COLOR_PURPLE_B << "Example 3" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::stack -> push[0..3] top: ";
+	for (int i = 0; i < 4; ++i)
+		st.push(i * 10);
+	std::cout << st.top() << ", inline: 1";
+	st.push(40);
+	st.push(50);
+	std::cout << ", push[40],[50] top: " << st.top() << ", inline: 0";
+	std::stack<int, std::vector<int> >	st2(st);
+	st2.pop();
+	std::cout << ", copy and pop top: " << st2.top();
+	std::cout << ", equal: " << (st == st2) << ", size: " << st.size() << '.';
+	std::cout << COLOR_END << std::endl;
+
+	ft::stack<int, ft::small_vector<int, 4> >	ft_st;
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::stack  -> push[0..3] top: ";
+	for (int i = 0; i < 4; ++i)
+		ft_st.push(i * 10);
+	std::cout << ft_st.top() << ", inline: " << topInside(ft_st);
+	ft_st.push(40);
+	ft_st.push(50);
+	std::cout << ", push[40],[50] top: " << ft_st.top();
+	std::cout << ", inline: " << topInside(ft_st);
+	ft::stack<int, ft::small_vector<int, 4> >	ft_st2(ft_st);
+	ft_st2.pop();
+	std::cout << ", copy and pop top: " << ft_st2.top();
+	std::cout << ", equal: " << (ft_st == ft_st2) << ", size: " << ft_st.size() << '.';
+	std::cout << COLOR_END << std::endl;
+}
+
 void	stack_test()
 {
 	example1();
 	example2();
+	example3();
 }
 
 #endif
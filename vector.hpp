@@ -16,18 +16,173 @@
 #include <memory>
 #include <vector>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
 #include <iterator>
+#include <algorithm>
+#include <new>
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
 #include "vector_iterator.hpp"
 
 namespace ft
 {
-	template < typename T, typename Alloc = std::allocator<T> >
+	// Allocator on top of malloc and free. Unlike std::allocator it may be handed back a
+	// larger block than it asked for, which is what lets grow_claim_slack use the slack.
+	template <typename T>
+	class malloc_allocator
+	{
+		public:
+			typedef T				value_type;
+			typedef T*				pointer;
+			typedef const T*		const_pointer;
+			typedef T&				reference;
+			typedef const T&		const_reference;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			template <typename U>
+			struct rebind { typedef malloc_allocator<U> other; };
+
+			malloc_allocator() {}
+			template <typename U>
+			malloc_allocator(const malloc_allocator<U>&) {}
+
+			pointer allocate(size_type n)
+			{
+				if (n > max_size())
+					throw std::bad_alloc();
+				void* p = std::malloc(n ? n * sizeof(T) : 1);
+				if (!p)
+					throw std::bad_alloc();
+				return static_cast<pointer>(p);
+			}
+
+			void deallocate(pointer p, size_type) { std::free(p); }
+
+			template <typename U, typename... Args>
+			void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+
+			template <typename U>
+			void destroy(U* p) { p->~U(); }
+
+			size_type max_size() const { return static_cast<size_type>(-1) / sizeof(T); }
+
+			bool operator==(const malloc_allocator&) const { return true; }
+			bool operator!=(const malloc_allocator&) const { return false; }
+	};
+
+	// How many elements a block from Alloc really holds when n were asked for. Only known
+	// for malloc_allocator on glibc, everything else reports exactly n.
+	template <typename Alloc>
+	struct allocator_slack
+	{
+		static std::size_t usable(const Alloc&, typename Alloc::pointer, std::size_t n) { return n; }
+	};
+
+#ifdef __GLIBC__
+	template <typename T>
+	struct allocator_slack<ft::malloc_allocator<T> >
+	{
+		static std::size_t usable(const ft::malloc_allocator<T>&, T* p, std::size_t n)
+		{
+			std::size_t got = malloc_usable_size(p) / sizeof(T);
+			return got > n ? got : n;
+		}
+	};
+#endif
+
+	// Whether Alloc can resize a block it handed out, keeping its contents, without the
+	// vector copying them (see mmap_allocator.hpp). A specialization with value set adds
+	// reallocate(alloc, p, n, newN), which returns the block, maybe moved, or null when it
+	// cannot and the vector must copy as usual. A stable allocator never moves the block,
+	// so any element type may use it. The primary template names nothing of Alloc, since
+	// it is looked at by every vector, whatever its element type.
+	template <typename Alloc>
+	struct allocator_realloc
+	{
+		static const bool value = false;
+		static const bool stable = false;
+	};
+
+	// Growth policies.
+	// A policy picks the capacity of the next buffer when an insertion does not fit, from
+	// the current capacity, the size that must fit and the element size. Once the buffer
+	// is allocated, claim() may raise the capacity to what the allocator really handed back.
+	// Every growing path of the vector (push_back, emplace, insert, resize) goes through it.
+
+	// 2x: the fewest reallocations, but up to half of the buffer sits idle after growing.
+	struct grow_double
+	{
+		static std::size_t next(std::size_t capacity, std::size_t required, std::size_t)
+		{
+			std::size_t n = capacity ? capacity * 2 : 1;
+			return n < required ? required : n;
+		}
+
+		template <typename Alloc>
+		static std::size_t claim(const Alloc&, typename Alloc::pointer, std::size_t n) { return n; }
+	};
+
+	// 1.5x: about a third more reallocations than 2x for a lower peak footprint, and
+	// freed blocks can add up to a later request.
+	struct grow_half
+	{
+		static std::size_t next(std::size_t capacity, std::size_t required, std::size_t)
+		{
+			std::size_t n = capacity + (capacity + 1) / 2;
+			return n < required ? required : n;
+		}
+
+		template <typename Alloc>
+		static std::size_t claim(const Alloc&, typename Alloc::pointer, std::size_t n) { return n; }
+	};
+
+	// Rounds buffers of Threshold bytes or more up to whole pages, which large blocks get
+	// from the system anyway, so the tail of the last page is not wasted.
+	template <typename Base = ft::grow_double, std::size_t Threshold = 65536, std::size_t PageSize = 4096>
+	struct grow_page_rounded
+	{
+		static std::size_t next(std::size_t capacity, std::size_t required, std::size_t elemSize)
+		{
+			std::size_t n = Base::next(capacity, required, elemSize);
+			if (n * elemSize < Threshold)
+				return n;
+			std::size_t bytes = (n * elemSize + PageSize - 1) / PageSize * PageSize;
+			return bytes / elemSize;
+		}
+
+		template <typename Alloc>
+		static std::size_t claim(const Alloc& alloc, typename Alloc::pointer p, std::size_t n) { return Base::claim(alloc, p, n); }
+	};
+
+	// Grows like Base, then keeps whatever the allocator added to the request as capacity
+	// (see allocator_slack, it needs ft::malloc_allocator to find any).
+	template <typename Base = ft::grow_double>
+	struct grow_claim_slack
+	{
+		static std::size_t next(std::size_t capacity, std::size_t required, std::size_t elemSize)
+		{
+			return Base::next(capacity, required, elemSize);
+		}
+
+		template <typename Alloc>
+		static std::size_t claim(const Alloc& alloc, typename Alloc::pointer p, std::size_t n)
+		{
+			return ft::allocator_slack<Alloc>::usable(alloc, p, n);
+		}
+	};
+
+	template < typename T, typename Alloc = std::allocator<T>, typename Growth = ft::grow_double >
 	class vector
 	{
 		public:
 			typedef T												value_type;
 			typedef std::size_t										size_type;
 			typedef Alloc											allocator_type;
+			typedef Growth											growth_policy;
 
 			typedef T&												reference;
 			typedef const T&										const_reference;
@@ -42,6 +197,10 @@ namespace ft
 			typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
 
 		protected:
+			// Set when growing may resize the buffer in place, see allocator_realloc.
+			typedef ft::integral_constant<bool, ft::allocator_realloc<Alloc>::value
+				&& (ft::is_trivially_copyable<T>::value || ft::allocator_realloc<Alloc>::stable)>	relocate_tag;
+
 			allocator_type		m_alloc;
 			size_type			m_size;
 			size_type			m_capacity;
@@ -56,32 +215,56 @@ namespace ft
 				m_alloc = alloc;
 				m_size = 0;
 				m_capacity = 0;
-				m_data = m_alloc.allocate(0);
+				m_data = 0;
 			}
-			// Fill.
+			// Fill. A throwing copy gives back what was built, buffer included.
 			vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = Alloc())
 			{
 				m_alloc = alloc;
 				m_size = n;
 				m_capacity = n;
-				m_data = this->m_alloc.allocate(m_size);
+				m_data = newBuffer(m_size);
 				size_type i = 0;
-				while ( i < n )
-					this->m_alloc.construct(m_data + i++, val);
+				try
+				{
+					for (; i < n; ++i)
+						this->m_alloc.construct(m_data + i, val);
+				}
+				catch (...)
+				{
+					destroyElements(m_data, i);
+					releaseBuffer();
+					throw ;
+				}
 			}
-			// Copy.
+			// Copy, sized to the elements, not to other's capacity. The allocator is the one
+			// copy's selects for a copy, a polymorphic_allocator's default resource for one.
 			vector (const vector &copy)
 			{
-				m_capacity = copy.m_capacity;
+				m_capacity = copy.m_size;
 				m_size = copy.m_size;
-				m_alloc = copy.m_alloc;
-				this->m_data = m_alloc.allocate(m_capacity);
-				size_type i = 0;
-				while (i < m_size)
+				m_alloc = std::allocator_traits<Alloc>::select_on_container_copy_construction(copy.m_alloc);
+				this->m_data = newBuffer(m_capacity);
+				try
 				{
-					m_alloc.construct(m_data + i, copy.m_data[i]);
-					i++;
+					copyElements(m_data, copy.m_data, m_size);
 				}
+				catch (...)
+				{
+					releaseBuffer();
+					throw ;
+				}
+			}
+			// Move, takes over the buffer and leaves other empty.
+			vector (vector&& other) noexcept
+			{
+				m_alloc = other.m_alloc;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				m_data = other.m_data;
+				other.m_size = 0;
+				other.m_capacity = 0;
+				other.m_data = 0;
 			}
 			// Range.
 			template <typename InputIterator>
@@ -90,16 +273,21 @@ namespace ft
 			typename ft::enable_if<!ft::is_integral<InputIterator>::value>::type* = 0)
 			{
 				m_alloc = alloc;
-				value_type len = ft::distance(first, last);
+				size_type len = ft::distance(first, last);
 				m_size = len;
 				m_capacity = len;
-				m_data = this->m_alloc.allocate(m_capacity);
-				value_type i = 0;
-				while (i < len)
+				m_data = newBuffer(m_capacity);
+				size_type i = 0;
+				try
 				{
-					this->m_alloc.construct((m_data + i), *first);
-					first++;
-					i++;
+					for (; i < len; ++i, ++first)
+						this->m_alloc.construct(m_data + i, *first);
+				}
+				catch (...)
+				{
+					destroyElements(m_data, i);
+					releaseBuffer();
+					throw ;
 				}
 			}
 			// Destroy.
@@ -107,28 +295,74 @@ namespace ft
 			{
 				while (m_size > 0)
 					pop_back();
-				m_alloc.deallocate(m_data, m_capacity);
+				releaseBuffer();
 			}
 
 // __ Membor Functions
 
-			// Operator=.
+			// Operator=. Copies into our buffer when it holds other's elements, otherwise
+			// into a new one of exactly their size. Our allocator stays unless it propagates
+			// on copy assignment: a vector assigned from one in a per-request arena keeps
+			// its own storage.
 			vector& operator=(const vector& other)
 			{
 				if (this == &other)
 					return *this;
-				while (m_size > 0) pop_back();
-				m_alloc.deallocate(m_data, m_capacity);
-				this->m_capacity = other.m_capacity;
-				this->m_alloc = other.m_alloc;
-				this->m_size = other.m_size;
-				this->m_data = m_alloc.allocate(m_capacity);
-				size_type i = 0;
-				while (i < m_size)
+				allocator_type alloc(std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value
+					? other.m_alloc : m_alloc);
+				if (other.m_size <= m_capacity && m_alloc == alloc)
 				{
-					m_alloc.construct(m_data + i, other.m_data[i]);
-					i++;
+					assignElements(other.m_data, other.m_size);
+					return *this;
+				}
+				pointer data = other.m_size ? alloc.allocate(other.m_size) : 0;
+				try
+				{
+					copyElements(data, other.m_data, other.m_size);
+				}
+				catch (...)
+				{
+					if (data)
+						alloc.deallocate(data, other.m_size);
+					throw ;
 				}
+				clear();
+				releaseBuffer();
+				m_alloc = alloc;
+				m_data = data;
+				m_size = other.m_size;
+				m_capacity = other.m_size;
+				return *this;
+			}
+
+			// Move assignment, drops our elements and takes over other's buffer. When our
+			// allocator does not propagate on move and differs from other's, the elements
+			// are moved one by one into our own storage instead.
+			vector& operator=(vector&& other)
+			noexcept(std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value
+				|| std::allocator_traits<Alloc>::is_always_equal::value)
+			{
+				if (this == &other)
+					return *this;
+				if (!std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value
+					&& !(m_alloc == other.m_alloc))
+				{
+					clear();
+					reserve(other.m_size);
+					transferElements(m_data, other.m_data, other.m_size);
+					m_size = other.m_size;
+					other.clear();
+					return *this;
+				}
+				clear();
+				releaseBuffer();
+				m_alloc = other.m_alloc;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				m_data = other.m_data;
+				other.m_size = 0;
+				other.m_capacity = 0;
+				other.m_data = 0;
 				return *this;
 			}
 
@@ -142,9 +376,12 @@ namespace ft
 					pop_back();
 				if (count > m_capacity)
 				{
-					m_alloc.deallocate(m_data, m_capacity);
-					m_data = m_alloc.allocate(count);
-					m_capacity = count;
+					releaseBuffer();
+					m_data = 0;
+					m_capacity = 0;
+					size_type cap = count;
+					m_data = allocateBuffer(cap);
+					m_capacity = cap;
 				}
 				size_type i = 0;
 				while (i < count)
@@ -165,9 +402,12 @@ namespace ft
 				size_type count = ft::distance(first, last);
 				if (count > m_capacity)
 				{
-					m_alloc.deallocate(m_data, m_capacity);
-					m_data = m_alloc.allocate(count);
-					m_capacity = count;
+					releaseBuffer();
+					m_data = 0;
+					m_capacity = 0;
+					size_type cap = count;
+					m_data = allocateBuffer(cap);
+					m_capacity = cap;
 				}
 				size_type i = 0;
 				while (i < count)
@@ -198,25 +438,48 @@ namespace ft
 			{
 				if (new_cap > max_size())
 					throw std::length_error("Length error");
-				if (new_cap < m_capacity)
+				if (new_cap <= m_capacity || resizeInPlace(new_cap))
 					return;
-				T* newAlloc = m_alloc.allocate(new_cap);
-				size_type i = 0;
-				while (i < m_size)
+				T* newAlloc = allocateBuffer(new_cap);
+				try
 				{
-					m_alloc.construct(newAlloc + i, m_data[i]);
-					i++;
+					transferElements(newAlloc, m_data, m_size);
 				}
-				i = 0;
-				while (i < m_size)
+				catch (...)
 				{
-					m_alloc.destroy(m_data + i);
-					i++;
+					m_alloc.deallocate(newAlloc, new_cap);
+					throw ;
 				}
-				if (m_data)
-					m_alloc.deallocate(m_data, m_capacity);
-				m_capacity = new_cap;
-				m_data = newAlloc;
+				adopt(newAlloc, new_cap);
+			}
+
+			// Shrink to fit, gives back the capacity beyond size(). The elements are moved to
+			// a buffer of their size, or stay in place when the allocator can shrink theirs.
+			void shrink_to_fit()
+			{
+				if (m_capacity == m_size)
+					return ;
+				if (m_size == 0)
+				{
+					releaseBuffer();
+					m_data = 0;
+					m_capacity = 0;
+					return ;
+				}
+				if (resizeInPlace(m_size))
+					return ;
+				size_type cap = m_size;
+				pointer data = allocateBuffer(cap);
+				try
+				{
+					transferElements(data, m_data, m_size);
+				}
+				catch (...)
+				{
+					m_alloc.deallocate(data, cap);
+					throw ;
+				}
+				adopt(data, cap);
 			}
 
 // __ Modifiers
@@ -239,69 +502,24 @@ namespace ft
 				this->insert(pos, 1, value);
 				return (this->begin() + start);
 			}
+
+			// Insert by move.
+			iterator insert(iterator pos, T&& value)
+			{
+				return emplace(pos, std::move(value));
+			}
 	
-			// Insert fill.
+			// Insert fill. The value is copied first, it may be one of our elements.
 			void insert(iterator pos, size_type count, const T& value)
 			{
-				pointer		tmp;
-				size_type	start;
-				size_type	i;
-				size_type	j;
-
-				start =static_cast<size_type>(pos - this->begin());
-				i = 0;
-				j = 0;
+				size_type start = static_cast<size_type>(pos - this->begin());
 				if (count == 0)
 					return ;
-				else if (pos < this->begin() && pos > this->end())
-					throw std::logic_error("vector:insert error");
 				else if (this->max_size() < this->m_size + count)
 					throw std::length_error("vector:insert error");
-				if (this->m_size + count > this->m_capacity)
-				{
-					size_type	tmp_cap = (m_capacity * 2 >= this->m_size + count) ? \
-										 (this->m_capacity * 2) : (this->m_size + count);
-					tmp = this->m_alloc.allocate(tmp_cap);
-					try
-					{
-						for (; i < start; ++i)
-							this->m_alloc.construct(tmp + i, this->m_data[i]);
-						for (; j < count; ++j)
-							this->m_alloc.construct(tmp + i + j, value);
-						for (; i + j < (this->m_size + count); ++i)
-							this->m_alloc.construct(tmp + i + j, this->m_data[i]);
-						for (int t = 0; i < this->m_size; ++t)
-							this->m_alloc.destroy(this->m_alloc.address(this->m_data[t]));
-					}
-					catch (...)
-					{
-						for (size_type t = 0; t < i + j; t++)
-                			this->m_alloc.destroy(tmp + t);
-						this->m_alloc.deallocate(tmp, this->m_size + count);
-						throw ;
-					}
-					this->m_alloc.deallocate(this->m_data, this->m_capacity);
-					this->m_capacity = tmp_cap;
-					this->m_data = tmp;
-				}
-				else
-				{
-					for (size_type t = this->m_size + count - 1; t >= start; --t)
-					{
-						if (t >= start && t < start + count)
-							this->m_alloc.construct(this->m_data + t, value);
-						else if (t >= this->m_size)
-							this->m_alloc.construct(this->m_data + t, this->m_data[t - count]);
-						else if (t <= this->m_size && t >= start + count)
-						{
-							this->m_alloc.destroy(this->m_data + t);
-							this->m_alloc.construct(this->m_data + t, this->m_data[t - count]);
-						}
-						if (t == 0)
-							break ;
-					}
-				}
-				this->m_size = this->m_size + count;
+				T copy(value);
+				fill_source src = { copy };
+				insertElements(start, count, src);
 			}
 
 			// Insert range.
@@ -309,81 +527,38 @@ namespace ft
 			void insert(iterator pos, InputIt first, InputIt last,
 			typename enable_if<!is_integral<InputIt>::value, InputIt>::type* = NULL)
 			{
-				pointer		tmp;
-				size_type	start;
-				size_type	i;
-				size_type	j;
-				size_type	count;
-
-				count = static_cast<size_type>(ft::distance(first, last));
-				start = static_cast<size_type>(pos - this->begin());
-				i = 0;
-				j = 0;
+				size_type count = static_cast<size_type>(ft::distance(first, last));
+				size_type start = static_cast<size_type>(pos - this->begin());
 				if (count == 0)
 					return ;
-				else if (pos < this->begin() && pos > this->end())
-					throw std::logic_error("vector:insert error");
 				else if (this->max_size() < this->m_size + count)
 					throw std::length_error("vector:insert error");
-				if (this->m_size + count > this->m_capacity)
-				{
-					size_type	tmp_cap = (m_capacity * 2 >= this->m_size + count) ? \
-										 (this->m_capacity * 2) : (this->m_size + count);
-					tmp = this->m_alloc.allocate(tmp_cap);
-					try
-					{
-						for (; i < start; ++i)
-							this->m_alloc.construct(tmp + i, this->m_data[i]);
-						for (; j < count; ++j)
-							this->m_alloc.construct(tmp + i + j, *(first++));
-						for (; i + j < (this->m_size + count); ++i)
-							this->m_alloc.construct(tmp + i + j, this->m_data[i]);
-						for (int t = 0; i < this->m_size; ++t)
-							this->m_alloc.destroy(this->m_alloc.address(this->m_data[t]));
-					}
-					catch (...)
-					{
-						for (size_type t = 0; t < i + j; t++)
-            		    	this->m_alloc.destroy(tmp + t);
-						this->m_alloc.deallocate(tmp, this->m_size + count);
-						throw ;
-					}
-					this->m_alloc.deallocate(this->m_data, this->m_capacity);
-					this->m_capacity = tmp_cap;
-					this->m_data = tmp;
-				}
-				else
+				range_source<InputIt> src = { first, first, 0 };
+				insertElements(start, count, src);
+			}
+
+			// Emplace, constructs the element from args in place of pos. In the middle
+			// it is built aside first, since args may refer to our own elements.
+			template <typename... Args>
+			iterator emplace(iterator pos, Args&&... args)
+			{
+				size_type start = static_cast<size_type>(pos - this->begin());
+				if (start == m_size)
 				{
-					for (size_type t = this->m_size + count - 1; t >= start; --t)
-					{
-						if (t >= start && t < start + count)
-							this->m_alloc.construct(this->m_data + t, *(--last));
-						else if (t >= this->m_size)
-							this->m_alloc.construct(this->m_data + t, this->m_data[t - count]);
-						else if (t <= this->m_size && t >= start + count)
-						{
-							this->m_alloc.destroy(this->m_data + t);
-							this->m_alloc.construct(this->m_data + t, this->m_data[t - count]);
-						}
-						if (t == 0)
-							break ;
-					}
+					emplace_back(std::forward<Args>(args)...);
+					return iterator(m_data + start);
 				}
-				this->m_size = this->m_size + count;
+				T tmp(std::forward<Args>(args)...);
+				move_source src = { tmp };
+				insertElements(start, 1, src);
+				return iterator(m_data + start);
 			}
 
 			// Erase single element.
 			iterator erase(iterator pos)
 			{
 				size_type index = pos - begin();
-				m_alloc.destroy(m_data + index);
-				size_type i = index;
-				while (i < m_size - 1)
-				{
-					m_alloc.construct(m_data + i, m_data[i + 1]);
-					i++;
-				}
-				m_size--;
+				closeGap(index, 1);
 				return iterator(m_data + index);
 			}
 
@@ -392,35 +567,34 @@ namespace ft
 			{
 				size_type index = first - begin();
 				size_type count = last - first;
-				while (first != last)
-				{
-					m_alloc.destroy(first.base());
-					first++;
-				}
-				size_type temp = index;
-				while (last < this->end())
-				{
-					m_alloc.construct(m_data + temp, *last);
-					temp++;
-					last++;
-				}
-				m_size -= count;
+				closeGap(index, count);
 				return iterator(m_data + index);
 			}
 
 			// Push Back.
 			void push_back(const value_type& val)
 			{
-				if (m_size == m_capacity)
+				emplace_back(val);
+			}
+
+			// Push Back by move.
+			void push_back(value_type&& val)
+			{
+				emplace_back(std::move(val));
+			}
+
+			// Emplace Back. When full, the new element is built in the new buffer before
+			// the others move there, since args may refer to one of them.
+			template <typename... Args>
+			void emplace_back(Args&&... args)
+			{
+				if (m_size < m_capacity)
 				{
-					if (m_capacity == 0)
-						m_capacity = m_capacity + 1;
-					else
-						m_capacity = (m_capacity * 2);
-					this->reserve(m_capacity);
+					m_alloc.construct(m_data + m_size, std::forward<Args>(args)...);
+					m_size++;
+					return ;
 				}
-				this->m_alloc.construct(m_data + m_size, val);
-				m_size++;
+				emplaceRealloc(relocate_tag(), std::forward<Args>(args)...);
 			}
 
 			// Pop Back.
@@ -430,6 +604,7 @@ namespace ft
 				m_alloc.destroy(m_data + m_size);
 			}
 
+
 			// Clear.
 			void clear()
 			{
@@ -442,25 +617,13 @@ namespace ft
 			{
 				if (m_size > count)
 				{
-					size_type i = count;
-					while (i > m_size)
-					{
-						m_alloc.destroy(m_data + i);
-						i++;
-					}
+					destroyElements(m_data + count, m_size - count);
 					m_size = count;
 				}
 				else if (m_size < count)
 				{
 					if (m_capacity < count)
-					{
-						value_type new_cap;
-						if (m_capacity * 2 > count)
-							new_cap = m_capacity * 2;
-						else
-							new_cap = count;
-						reserve(new_cap);
-					}
+						reserve(grownCapacity(count));
 					size_type i = m_size;
 					while (i < count)
 					{
@@ -471,6 +634,32 @@ namespace ft
 				}
 			}
 
+			// Resize, with new elements default-initialized rather than value-initialized:
+			// trivial ones, bytes or floats, keep whatever the memory held, for the caller
+			// to fill through data() without a zeroing pass first.
+			void resize_default_init(size_type count)
+			{
+				if (m_size > count)
+				{
+					destroyElements(m_data + count, m_size - count);
+					m_size = count;
+					return ;
+				}
+				if (m_capacity < count)
+					reserve(grownCapacity(count));
+				defaultElements(count, ft::is_trivially_default_constructible<T>());
+			}
+
+			// Grows by n default-initialized elements, see resize_default_init(), and
+			// returns the first of them for read() or a decoder to write into.
+			pointer append_uninitialized(size_type n)
+			{
+				if (n > max_size() - m_size)
+					throw std::length_error("vector: length error");
+				resize_default_init(m_size + n);
+				return m_data + m_size - n;
+			}
+
 			// Swap.
 			void swap(vector &x)
 			{
@@ -525,36 +714,357 @@ namespace ft
 			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
 			const_reverse_iterator rend() const { return const_reverse_iterator(end()); }
 
+// __ Element Transfer
+
+		private:
+			// Copy-constructs n elements into raw storage, with one memcpy when the
+			// type allows it.
+			void copyElements(pointer dest, const_pointer src, size_type n)
+			{
+				copyElements(dest, src, n, ft::is_trivially_copyable<T>());
+			}
+
+			void copyElements(pointer dest, const_pointer src, size_type n, ft::true_type)
+			{
+				if (n)
+					std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+			}
+
+			void copyElements(pointer dest, const_pointer src, size_type n, ft::false_type)
+			{
+				size_type i = 0;
+				try
+				{
+					for (; i < n; ++i)
+						m_alloc.construct(dest + i, src[i]);
+				}
+				catch (...)
+				{
+					destroyElements(dest, i);
+					throw ;
+				}
+			}
+
+			// Default-initializes elements up to count, in place, nothing to run for trivial ones.
+			void defaultElements(size_type count, ft::true_type)
+			{
+				m_size = count;
+			}
+
+			void defaultElements(size_type count, ft::false_type)
+			{
+				while (m_size < count)
+				{
+					::new (static_cast<void*>(m_data + m_size)) value_type;
+					m_size++;
+				}
+			}
+
+			// Makes our elements a copy of n others, in our buffer, which must hold them.
+			void assignElements(const_pointer src, size_type n)
+			{
+				if (ft::is_trivially_copyable<T>::value)
+				{
+					copyElements(m_data, src, n);
+					m_size = n;
+					return ;
+				}
+				size_type common = m_size < n ? m_size : n;
+				for (size_type i = 0; i < common; ++i)
+					m_data[i] = src[i];
+				if (n < m_size)
+					destroyElements(m_data + n, m_size - n);
+				else
+					copyElements(m_data + m_size, src + m_size, n - m_size);
+				m_size = n;
+			}
+
+			// Destroys n elements, nothing to do for trivially destructible ones.
+			void destroyElements(pointer first, size_type n)
+			{
+				if (ft::is_trivially_destructible<T>::value)
+					return ;
+				for (size_type i = 0; i < n; ++i)
+					m_alloc.destroy(first + i);
+			}
+
+			// Slow path of emplace_back, when the buffer is full.
+			template <typename... Args>
+			void emplaceRealloc(ft::false_type, Args&&... args)
+			{
+				size_type newCap = grownCapacity(m_size + 1);
+				pointer tmp = allocateBuffer(newCap);
+				try
+				{
+					m_alloc.construct(tmp + m_size, std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					m_alloc.deallocate(tmp, newCap);
+					throw ;
+				}
+				try
+				{
+					transferElements(tmp, m_data, m_size);
+				}
+				catch (...)
+				{
+					m_alloc.destroy(tmp + m_size);
+					m_alloc.deallocate(tmp, newCap);
+					throw ;
+				}
+				adopt(tmp, newCap);
+				m_size++;
+			}
+
+			// The element is built aside first, args may point into pages about to move.
+			template <typename... Args>
+			void emplaceRealloc(ft::true_type, Args&&... args)
+			{
+				value_type value(std::forward<Args>(args)...);
+				if (!resizeInPlace(grownCapacity(m_size + 1)))
+					return emplaceRealloc(ft::false_type(), std::move(value));
+				m_alloc.construct(m_data + m_size, std::move(value));
+				m_size++;
+			}
+
+			// Resizes the buffer to newCap in place when the allocator can resize it and the
+			// elements may be moved as bytes, or it never moves them. Unless the allocator is
+			// stable, any pointer into the old buffer is then stale.
+			bool resizeInPlace(size_type newCap)
+			{
+				return resizeInPlace(newCap, relocate_tag());
+			}
+
+			bool resizeInPlace(size_type, ft::false_type) { return false; }
+
+			bool resizeInPlace(size_type newCap, ft::true_type)
+			{
+				if (!m_data)
+					return false;
+				pointer p = ft::allocator_realloc<Alloc>::reallocate(m_alloc, m_data, m_capacity, newCap);
+				if (!p)
+					return false;
+				m_data = p;
+				m_capacity = Growth::claim(m_alloc, p, newCap);
+				return true;
+			}
+
+			// Buffer for exactly n elements, none for zero so that empty vectors never
+			// reach the allocator.
+			pointer newBuffer(size_type n)
+			{
+				return n ? m_alloc.allocate(n) : 0;
+			}
+
+			// Gives the buffer back, if there is one.
+			void releaseBuffer()
+			{
+				if (m_data)
+					m_alloc.deallocate(m_data, m_capacity);
+			}
+
+			// Capacity of the next buffer when `required` elements must fit, by the growth policy.
+			size_type grownCapacity(size_type required) const
+			{
+				if (required > max_size())
+					throw std::length_error("vector: length error");
+				size_type n = Growth::next(m_capacity, required, sizeof(T));
+				return (n < required || n > max_size()) ? required : n;
+			}
+
+			// Allocates room for n elements, then raises n to what the growth policy could
+			// claim of the block. The buffer is later deallocated with that raised count.
+			pointer allocateBuffer(size_type& n)
+			{
+				pointer p = m_alloc.allocate(n);
+				n = Growth::claim(m_alloc, p, n);
+				return p;
+			}
+
+			// Move-constructs n elements into new storage, copying instead when the move
+			// could throw so that the source stays intact if anything fails. The caller
+			// destroys the source once all went well.
+			void transferElements(pointer dest, pointer src, size_type n)
+			{
+				transferElements(dest, src, n, ft::is_trivially_copyable<T>());
+			}
+
+			void transferElements(pointer dest, pointer src, size_type n, ft::true_type)
+			{
+				copyElements(dest, src, n, ft::true_type());
+			}
+
+			void transferElements(pointer dest, pointer src, size_type n, ft::false_type)
+			{
+				size_type i = 0;
+				try
+				{
+					for (; i < n; ++i)
+						m_alloc.construct(dest + i, std::move_if_noexcept(src[i]));
+				}
+				catch (...)
+				{
+					destroyElements(dest, i);
+					throw ;
+				}
+			}
+
+			// Replaces the buffer with one holding the same elements, already moved.
+			void adopt(pointer data, size_type capacity)
+			{
+				destroyElements(m_data, m_size);
+				releaseBuffer();
+				m_data = data;
+				m_capacity = capacity;
+			}
+
+			// What insertElements inserts: element i, built in raw storage or assigned
+			// over a live element.
+			struct fill_source
+			{
+				const T&	value;
+				void construct(allocator_type& alloc, pointer p, size_type) const { alloc.construct(p, value); }
+				void assign(pointer p, size_type) const { *p = value; }
+			};
+
+			template <typename It>
+			struct range_source
+			{
+				It			first;
+				It			cur;
+				size_type	pos;
+				It at(size_type i)
+				{
+					if (i < pos)
+					{
+						cur = first;
+						pos = 0;
+					}
+					for (; pos < i; ++pos)
+						++cur;
+					return cur;
+				}
+				void construct(allocator_type& alloc, pointer p, size_type i) { alloc.construct(p, *at(i)); }
+				void assign(pointer p, size_type i) { *p = *at(i); }
+			};
+
+			struct move_source
+			{
+				T&	value;
+				void construct(allocator_type& alloc, pointer p, size_type) const { alloc.construct(p, std::move(value)); }
+				void assign(pointer p, size_type) const { *p = std::move(value); }
+			};
+
+			// Inserts count elements from src at start, growing like insert always did.
+			// A reallocation builds the new elements first and leaves us untouched if
+			// anything throws. In place, the elements that land past the end are
+			// constructed there and the rest of the tail slides up by move assignment,
+			// so every slot below the end stays live whatever throws.
+			template <typename Source>
+			void insertElements(size_type start, size_type count, Source& src)
+			{
+				if (m_size + count > m_capacity && !resizeInPlace(grownCapacity(m_size + count)))
+				{
+					size_type newCap = grownCapacity(m_size + count);
+					pointer tmp = allocateBuffer(newCap);
+					size_type built = 0;
+					bool head = false;
+					try
+					{
+						for (; built < count; ++built)
+							src.construct(m_alloc, tmp + start + built, built);
+						transferElements(tmp, m_data, start);
+						head = true;
+						transferElements(tmp + start + count, m_data + start, m_size - start);
+					}
+					catch (...)
+					{
+						if (head)
+							destroyElements(tmp, start);
+						destroyElements(tmp + start, built);
+						m_alloc.deallocate(tmp, newCap);
+						throw ;
+					}
+					adopt(tmp, newCap);
+					m_size += count;
+					return ;
+				}
+				pointer pos = m_data + start;
+				pointer end = m_data + m_size;
+				size_type tail = m_size - start;
+				if (tail >= count)
+				{
+					transferElements(end, end - count, count);
+					m_size += count;
+					std::move_backward(pos, end - count, end);
+					for (size_type i = 0; i < count; ++i)
+						src.assign(pos + i, i);
+					return ;
+				}
+				size_type built = tail;
+				try
+				{
+					for (; built < count; ++built)
+						src.construct(m_alloc, pos + built, built);
+				}
+				catch (...)
+				{
+					destroyElements(end, built - tail);
+					throw ;
+				}
+				try
+				{
+					transferElements(pos + count, pos, tail);
+				}
+				catch (...)
+				{
+					destroyElements(end, count - tail);
+					throw ;
+				}
+				m_size += count;
+				for (size_type i = 0; i < tail; ++i)
+					src.assign(pos + i, i);
+			}
+
+			// Removes count elements at start, sliding the tail down by move assignment and
+			// destroying the vacated end.
+			void closeGap(size_type start, size_type count)
+			{
+				std::move(m_data + start + count, m_data + m_size, m_data + start);
+				destroyElements(m_data + m_size - count, count);
+				m_size -= count;
+			}
 	};
 
 // __ Operators
 
-			template <typename T, typename Alloc>
-			bool operator==(const ft::vector<T,Alloc> &v1, const ft::vector<T,Alloc> &v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator==(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth> &v2)
 			{ return v1.size() == v2.size() && ft::equal(v1.begin(), v1.end(), v2.begin()); }
 
-			template <typename T, typename Alloc>
-			bool operator!=(const ft::vector<T,Alloc> &v1, const ft::vector<T,Alloc> &v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator!=(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth> &v2)
 			{ return !(v1 == v2); }
 
-			template <typename T, typename Alloc>
-			bool operator>(const ft::vector<T,Alloc> &v1, const ft::vector<T,Alloc> &v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator>(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth> &v2)
 			{ return v2 < v1; }
 
-			template <typename T, typename Alloc>
-			bool operator<(const ft::vector<T,Alloc> &v1, const ft::vector<T,Alloc>& v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator<(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth>& v2)
 			{ return ft::lexicographical_compare(v1.begin(), v1.end(), v2.begin(), v2.end()); }
 
-			template <typename T, typename Alloc>
-			bool operator>=(const ft::vector<T,Alloc> &v1, const ft::vector<T,Alloc> &v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator>=(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth> &v2)
 			{ return !(v1 < v2); }
 
-			template <typename T, typename Alloc>
-			bool operator<=(const ft::vector<T, Alloc> &v1, const ft::vector<T,Alloc> &v2)
+			template <typename T, typename Alloc, typename Growth>
+			bool operator<=(const ft::vector<T,Alloc,Growth> &v1, const ft::vector<T,Alloc,Growth> &v2)
 			{ return !(v2 < v1); }
 
-			template <typename T, typename Alloc>
-			void swap(vector<T,Alloc> &x, vector<T,Alloc> &y)
+			template <typename T, typename Alloc, typename Growth>
+			void swap(vector<T,Alloc,Growth> &x, vector<T,Alloc,Growth> &y)
 			{ x.swap(y); }
 }
 
@@ -77,6 +77,21 @@ namespace ft
 		return (first2 != last2);
 	}
 
+	// Is Trivially Copyable.
+	// Objects that can be copied byte for byte with memcpy, as the compiler sees them.
+	template <typename T> struct	is_trivially_copyable
+		: ft::integral_constant<bool, __is_trivially_copyable(T)> {};
+
+	// Is Trivially Destructible.
+	// Objects whose destructor does nothing, so destroying them can be skipped.
+	template <typename T> struct	is_trivially_destructible
+		: ft::integral_constant<bool, __has_trivial_destructor(T)> {};
+
+	// Is Trivially Default Constructible.
+	// Objects whose default constructor does nothing, so a new one may be left as raw memory.
+	template <typename T> struct	is_trivially_default_constructible
+		: ft::integral_constant<bool, __has_trivial_constructor(T)> {};
+
 	// Enable If.
 	template <bool U, class T = void> struct enable_if {};
 	template <class T> struct enable_if<true, T> { typedef T	type; };
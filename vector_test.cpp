@@ -2,7 +2,12 @@
 #include <iomanip>
 #include <vector>
 #include <stdexcept>
+#include <string>
+#include <cstring>
 #include "vector.hpp"
+#include "mmap_allocator.hpp"
+#include "stable_vector.hpp"
+#include "small_vector.hpp"
 
 #ifndef	MYCOLORS_HPP
 # define MYCOLORS_HPP
@@ -1656,6 +1661,365 @@ static void	example28()
 	std::cout << '.' << COLOR_END << std::endl;
 }
 
+struct	Point
+{
+	int		x;
+	int		y;
+};
+
+static void	example29()
+{
+	/* Example 29 */
+	/* Example for trivially copyable elements: insert, erase and copies move raw bytes */
+
+	Point	pts[] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+
+	std::cout << COLOR_PURPLE_B << "Example 29" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<Point> vct(pts, pts + 4);
+	vct.insert(vct.begin() + 1, 3, vct[3]);
+	vct.insert(vct.end(), pts, pts + 2);
+	vct.erase(vct.begin() + 2, vct.begin() + 4);
+	vct.erase(vct.begin());
+	std::vector<Point> cpy(vct);
+	cpy.reserve(100);
+	std::cout << " size: " << cpy.size() << ", value:";
+	for (std::vector<Point>::iterator first = cpy.begin(); first != cpy.end(); ++first)
+		std::cout << " (" << first->x << "," << first->y << ")";
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<Point> ft_vct(pts, pts + 4);
+	ft_vct.insert(ft_vct.begin() + 1, 3, ft_vct[3]);
+	ft_vct.insert(ft_vct.end(), pts, pts + 2);
+	ft_vct.erase(ft_vct.begin() + 2, ft_vct.begin() + 4);
+	ft_vct.erase(ft_vct.begin());
+	ft::vector<Point> ft_cpy(ft_vct);
+	ft_cpy.reserve(100);
+	std::cout << " size: " << ft_cpy.size() << ", value:";
+	for (ft::vector<Point>::iterator first = ft_cpy.begin(); first != ft_cpy.end(); ++first)
+		std::cout << " (" << first->x << "," << first->y << ")";
+	std::cout << '.' << COLOR_END << std::endl;
+}
+
+static void	example30()
+{
+	/* Example 30 */
+	/* Example for push_back of an rvalue, emplace_back, emplace and move constructor */
+
+	std::cout << COLOR_PURPLE_B << "Example 30" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<std::string> vct;
+	std::string word("forty-two");
+	vct.push_back(std::move(word));
+	vct.emplace_back(3, 'x');
+	vct.emplace(vct.begin() + 1, "middle");
+	vct.emplace(vct.begin(), vct[2]);
+	std::vector<std::string> moved(std::move(vct));
+	std::cout << " size: " << moved.size() << ", source size: " << vct.size() << ", value:";
+	for (std::vector<std::string>::iterator first = moved.begin(); first != moved.end(); ++first)
+		std::cout << " " << *first;
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<std::string> ft_vct;
+	std::string ft_word("forty-two");
+	ft_vct.push_back(std::move(ft_word));
+	ft_vct.emplace_back(3, 'x');
+	ft_vct.emplace(ft_vct.begin() + 1, "middle");
+	ft_vct.emplace(ft_vct.begin(), ft_vct[2]);
+	ft::vector<std::string> ft_moved(std::move(ft_vct));
+	std::cout << " size: " << ft_moved.size() << ", source size: " << ft_vct.size() << ", value:";
+	for (ft::vector<std::string>::iterator first = ft_moved.begin(); first != ft_moved.end(); ++first)
+		std::cout << " " << *first;
+	std::cout << '.' << COLOR_END << std::endl;
+}
+
+static void	example31()
+{
+	/* Example 31 */
+	/* Example for the growth policy: 1.5x growth for push_back, insert and resize */
+
+	std::cout << COLOR_PURPLE_B << "Example 31" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector -> capacities:";
+	std::vector<int> vct;
+	for (int i = 0; i < 30; ++i)
+	{
+		if (vct.size() == vct.capacity())
+		{
+			vct.reserve(vct.capacity() + (vct.capacity() + 1) / 2 + (vct.capacity() == 0));
+			std::cout << " " << vct.capacity();
+		}
+		vct.push_back(i);
+	}
+	vct.reserve(vct.capacity() + (vct.capacity() + 1) / 2);
+	vct.insert(vct.begin(), 15, -1);
+	std::cout << ", insert: " << vct.capacity();
+	vct.reserve(vct.capacity() + (vct.capacity() + 1) / 2);
+	vct.resize(vct.capacity() / 3 * 2 + 1);
+	std::cout << ", resize: " << vct.capacity() << ", size: " << vct.size();
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  -> capacities:";
+	ft::vector<int, std::allocator<int>, ft::grow_half> ft_vct;
+	for (int i = 0; i < 30; ++i)
+	{
+		ft::vector<int>::size_type cap = ft_vct.capacity();
+		ft_vct.push_back(i);
+		if (ft_vct.capacity() != cap)
+			std::cout << " " << ft_vct.capacity();
+	}
+	ft_vct.insert(ft_vct.begin(), 15, -1);
+	std::cout << ", insert: " << ft_vct.capacity();
+	ft_vct.resize(ft_vct.capacity() + 1);
+	std::cout << ", resize: " << ft_vct.capacity() << ", size: " << ft_vct.size();
+	std::cout << '.' << COLOR_END << std::endl;
+}
+
+static void	example32()
+{
+	/* Example 32 */
+	/* Example for ft::mmap_allocator: past 4096 bytes the buffer is mapped and grows with mremap */
+
+	std::cout << COLOR_PURPLE_B << "Example 32" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<double> vct;
+	for (int i = 0; i < 5000; ++i)
+		vct.push_back(i * 0.25);
+	vct.insert(vct.begin() + 10, 3000, -1.0);
+	vct.reserve(20000);
+	std::cout << " size: " << vct.size() << ", capacity: " << vct.capacity();
+	std::cout << ", value: " << vct[9] << " " << vct[10] << " " << vct[3010] << " " << vct.back();
+	std::cout << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<double, ft::mmap_allocator<double, 4096> > ft_vct;
+	for (int i = 0; i < 5000; ++i)
+		ft_vct.push_back(i * 0.25);
+	ft_vct.insert(ft_vct.begin() + 10, 3000, -1.0);
+	ft_vct.reserve(20000);
+	std::cout << " size: " << ft_vct.size() << ", capacity: " << ft_vct.capacity();
+	std::cout << ", value: " << ft_vct[9] << " " << ft_vct[10] << " " << ft_vct[3010] << " " << ft_vct.back();
+	std::cout << '.' << COLOR_END << std::endl;
+}
+
+static void	example33()
+{
+	/* Example 33 */
+	/* Example for ft::stable_vector: a pointer taken before growing stays valid */
+
+	std::cout << COLOR_PURPLE_B << "Example 33" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<std::string> vct;
+	vct.reserve(10001);
+	vct.push_back("first");
+	std::string* first = &vct[0];
+	for (int i = 0; i < 10000; ++i)
+		vct.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+	*first += "!";
+	std::cout << " size: " << vct.size() << ", same address: " << (first == &vct[0]);
+	std::cout << ", value: " << vct[0] << " " << vct[10000] << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::stable_vector<std::string> ft_vct;
+	ft_vct.push_back("first");
+	std::string* ft_first = &ft_vct[0];
+	for (int i = 0; i < 10000; ++i)
+		ft_vct.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+	*ft_first += "!";
+	std::cout << " size: " << ft_vct.size() << ", same address: " << (ft_first == &ft_vct[0]);
+	std::cout << ", value: " << ft_vct[0] << " " << ft_vct[10000] << '.' << COLOR_END << std::endl;
+}
+
+static void	example34()
+{
+	/* Example 34 */
+	/* Example for copies sized to the elements, shrink_to_fit and assignment into a large enough vector */
+
+	std::cout << COLOR_PURPLE_B << "Example 34" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<std::string> vct;
+	for (int i = 0; i < 1000; ++i)
+		vct.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+	vct.erase(vct.begin() + 10, vct.end());
+	std::vector<std::string> copy(vct);
+	std::cout << " copy capacity: " << copy.capacity();
+	std::vector<std::string> dst(50, "x");
+	const std::string* data = dst.data();
+	dst = vct;
+	std::cout << ", assigned capacity: " << dst.capacity() << ", same buffer: " << (data == dst.data());
+	vct.shrink_to_fit();
+	std::cout << ", shrunk capacity: " << vct.capacity() << ", value: " << vct[9] << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<std::string> ft_vct;
+	for (int i = 0; i < 1000; ++i)
+		ft_vct.push_back(std::string(i % 5 + 1, 'a' + i % 26));
+	ft_vct.erase(ft_vct.begin() + 10, ft_vct.end());
+	ft::vector<std::string> ft_copy(ft_vct);
+	std::cout << " copy capacity: " << ft_copy.capacity();
+	ft::vector<std::string> ft_dst(50, "x");
+	const std::string* ft_data = ft_dst.data();
+	ft_dst = ft_vct;
+	std::cout << ", assigned capacity: " << ft_dst.capacity() << ", same buffer: " << (ft_data == ft_dst.data());
+	ft_vct.shrink_to_fit();
+	std::cout << ", shrunk capacity: " << ft_vct.capacity() << ", value: " << ft_vct[9] << '.' << COLOR_END << std::endl;
+}
+
+static void	example35()
+{
+	/* Example 35 */
+	/* Example for resize_default_init and append_uninitialized: bytes filled through data() */
+
+	std::cout << COLOR_PURPLE_B << "Example 35" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<char> vct;
+	vct.resize(5);
+	std::memcpy(vct.data(), "hello", 5);
+	vct.resize(vct.size() + 6);
+	std::memcpy(vct.data() + 5, " world", 6);
+	std::vector<std::string> strs(2, "a");
+	strs.resize(4);
+	std::cout << " size: " << vct.size() << ", bytes: " << std::string(vct.data(), vct.size());
+	std::cout << ", strings: " << strs.size() << " [" << strs[1] << "][" << strs[3] << "]." << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<char> ft_vct;
+	ft_vct.resize_default_init(5);
+	std::memcpy(ft_vct.data(), "hello", 5);
+	std::memcpy(ft_vct.append_uninitialized(6), " world", 6);
+	ft::vector<std::string> ft_strs(2, "a");
+	ft_strs.resize_default_init(4);
+	std::cout << " size: " << ft_vct.size() << ", bytes: " << std::string(ft_vct.data(), ft_vct.size());
+	std::cout << ", strings: " << ft_strs.size() << " [" << ft_strs[1] << "][" << ft_strs[3] << "]." << COLOR_END << std::endl;
+}
+
+static void	example36()
+{
+	/* Example 36 */
+	/* Example for assign with grow_claim_slack over malloc_allocator: the claimed slack is capacity, not elements */
+
+	int	src[] = {4, 8, 15, 16, 23, 42, 7};
+
+	std::cout << COLOR_PURPLE_B << "Example 36" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<int> vct;
+	vct.assign(5, 1);
+	std::cout << " fill size: " << vct.size() << ", fits: " << (vct.capacity() >= vct.size());
+	vct.assign(src, src + 7);
+	std::cout << ", range size: " << vct.size() << ", value:";
+	for (std::vector<int>::iterator it = vct.begin(); it != vct.end(); ++it)
+		std::cout << " " << *it;
+	vct.assign(100, 3);
+	std::cout << ", refill size: " << vct.size() << ", back: " << vct.back() << '.' << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::vector<int, ft::malloc_allocator<int>, ft::grow_claim_slack<> > ft_vct;
+	ft_vct.assign(5, 1);
+	std::cout << " fill size: " << ft_vct.size() << ", fits: " << (ft_vct.capacity() >= ft_vct.size());
+	ft_vct.assign(src, src + 7);
+	std::cout << ", range size: " << ft_vct.size() << ", value:";
+	for (ft::vector<int, ft::malloc_allocator<int>, ft::grow_claim_slack<> >::iterator it = ft_vct.begin(); it != ft_vct.end(); ++it)
+		std::cout << " " << *it;
+	ft_vct.assign(100, 3);
+	std::cout << ", refill size: " << ft_vct.size() << ", back: " << ft_vct.back() << '.' << COLOR_END << std::endl;
+}
+
+// Prints the first letter of each string, they are long enough to live on the heap.
+template <typename Vector>
+static void	printLetters(const Vector& vct)
+{
+	for (typename Vector::const_iterator it = vct.begin(); it != vct.end(); ++it)
+		std::cout << (*it)[0];
+}
+
+static void	example37()
+{
+	/* Example 37 */
+	/* Example for small_vector of strings: insert, erase and swap across inline and spilled, move, shrink_to_fit back inline */
+
+	std::cout << COLOR_PURPLE_B << "Example 37" << COLOR_END << std::endl;
+	std::cout << COLOR_YELLOW_B;
+	std::cout << "std::vector ->";
+	std::vector<std::string> a;
+	std::vector<std::string> b;
+	for (int i = 0; i < 3; ++i)
+		a.push_back(std::string(24, 'a' + i));
+	for (int i = 0; i < 6; ++i)
+		b.push_back(std::string(24, 'k' + i));
+	a.insert(a.begin() + 1, std::string(24, 'x'));
+	b.erase(b.begin() + 1, b.begin() + 3);
+	std::cout << " a: ";
+	printLetters(a);
+	std::cout << " spilled 0, b: ";
+	printLetters(b);
+	std::cout << " spilled 1";
+	a.swap(b);
+	std::cout << ", swap a: ";
+	printLetters(a);
+	std::cout << " spilled 1, b: ";
+	printLetters(b);
+	std::cout << " spilled 0";
+	std::vector<std::string> c(std::move(a));
+	c.erase(c.begin());
+	c.shrink_to_fit();
+	std::cout << ", moved c: ";
+	printLetters(c);
+	std::cout << " spilled 0, a size: " << a.size();
+	b.insert(b.begin() + 2, 3, std::string(24, 'z'));
+	std::cout << ", b: ";
+	printLetters(b);
+	std::cout << " spilled 1." << COLOR_END << std::endl;
+
+	std::cout << COLOR_GREEN_B;
+	std::cout << "ft::vector  ->";
+	ft::small_vector<std::string, 4> ft_a;
+	ft::small_vector<std::string, 4> ft_b;
+	for (int i = 0; i < 3; ++i)
+		ft_a.push_back(std::string(24, 'a' + i));
+	for (int i = 0; i < 6; ++i)
+		ft_b.push_back(std::string(24, 'k' + i));
+	ft_a.insert(ft_a.begin() + 1, std::string(24, 'x'));
+	ft_b.erase(ft_b.begin() + 1, ft_b.begin() + 3);
+	std::cout << " a: ";
+	printLetters(ft_a);
+	std::cout << " spilled " << ft_a.spilled() << ", b: ";
+	printLetters(ft_b);
+	std::cout << " spilled " << ft_b.spilled();
+	ft_a.swap(ft_b);
+	std::cout << ", swap a: ";
+	printLetters(ft_a);
+	std::cout << " spilled " << ft_a.spilled() << ", b: ";
+	printLetters(ft_b);
+	std::cout << " spilled " << ft_b.spilled();
+	ft::small_vector<std::string, 4> ft_c(std::move(ft_a));
+	ft_c.erase(ft_c.begin());
+	ft_c.shrink_to_fit();
+	std::cout << ", moved c: ";
+	printLetters(ft_c);
+	std::cout << " spilled " << ft_c.spilled() << ", a size: " << ft_a.size();
+	ft_b.insert(ft_b.begin() + 2, 3, std::string(24, 'z'));
+	std::cout << ", b: ";
+	printLetters(ft_b);
+	std::cout << " spilled " << ft_b.spilled() << '.' << COLOR_END << std::endl;
+}
+
 void	vector_test()
 {
 	example1();
@@ -1686,4 +2050,13 @@ void	vector_test()
 	example26();
 	example27();
 	example28();
+	example29();
+	example30();
+	example31();
+	example32();
+	example33();
+	example34();
+	example35();
+	example36();
+	example37();
 }